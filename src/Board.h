@@ -1,53 +1,76 @@
 
 #pragma once
 
-#include <vector>
-#include <memory>
-#include <SFML/Graphics.hpp>
-#include "pieces/Piece.h"
+#include <type_traits>
+#include "ChessEngine/Position.h"
+#include "ChessEngine/MoveList.h"
 #include "Types.h"
 
+// how the game stands for the side to move
+enum class GameResult
+{
+    Ongoing,
+    Checkmate,
+    Stalemate,
+    InsufficientMaterial,
+    FiftyMoveDraw
+};
+
+// legal moves and outcome of one position, computed once per move and shared by the gui and the ai root
+struct GameStatus
+{
+    MoveList legalMoves;
+    bool inCheck = false;
+    GameResult result = GameResult::Ongoing;
+};
+
 class Board
 {
 public:
     Board();
-    Board(const Board &other);
 
     void initializeBoard();
 
-    void setupBoardGraphics();
+    // check whether a square holds a piece of a color
+    bool hasPieceAt(int x, int y, PieceColor color) const;
+
+    // play a move from the gui in place, throws if the start square is empty, the returned undo
+    // info takes it back with unmakeMove
+    UndoInfo makeMove(const Move &move);
 
-    void draw(sf::RenderWindow &window, Piece *selectedPiece, const std::vector<std::pair<int, int>> &validMoves);
+    // play a move of a color known at compile time without checking it, for the search where every
+    // move has passed the legality test
+    template <PieceColor Us>
+    UndoInfo makeMove(const Move &move)
+    {
+        UndoInfo undo;
+        position.makeMove<Us>(move, undo);
+        return undo;
+    }
 
-    Piece *getPieceAt(int x, int y) const;
+    void unmakeMove(const Move &move, const UndoInfo &undo);
 
-    std::vector<std::pair<int, int>> getValidMoves(Piece *piece, const std::pair<Piece *, std::pair<int, int>> &lastMove) const;
+    // pass the turn without moving, for null-move pruning
+    UndoInfo makeNullMove();
 
-    void movePiece(Piece *piece, int endX, int endY, bool enPassant, bool castling);
+    void unmakeNullMove(const UndoInfo &undo);
 
     bool isKingInCheck(PieceColor color) const;
 
-    bool hasValidMoves(PieceColor color) const;
+    // legal moves, check and result for the side to move
+    GameStatus computeGameStatus() const;
 
     bool isInsufficientMaterial() const;
 
-    bool isPathClear(int startX, int startY, int endX, int endY) const;
+    // a hundred halfmoves without a capture or pawn move
+    bool isFiftyMoveDraw() const;
 
-    bool isSquareUnderAttack(int x, int y, PieceColor color) const;
-
-    bool isOccupied(int x, int y) const;
-    bool isOccupiedByOpponent(int x, int y, PieceColor color) const;
-
-    bool canCastle(PieceColor color, bool isKingSide) const;
-
-    const std::vector<std::unique_ptr<Piece>> &getPieces() const { return pieces; }
+    const Position &getPosition() const { return position; }
 
 private:
-    std::vector<std::unique_ptr<Piece>> pieces;
-
-    sf::RectangleShape squares[8][8];
-
-    void removePieceAt(int x, int y);
-    void capturePieceAt(int x, int y);
-    void promotePawn(Piece *pawn);
+    // bitboard position all rule queries run on, drawing lives in BoardRenderer
+    Position position;
 };
+
+// the search copies boards freely, so they must stay plain data
+static_assert(std::is_trivially_copyable<Board>::value, "Board must stay trivially copyable");
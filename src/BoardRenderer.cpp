@@ -0,0 +1,105 @@
+#include "BoardRenderer.h"
+#include "ResourceManager/ResourceManager.h"
+
+// constructor for boardrenderer
+BoardRenderer::BoardRenderer()
+    : highlight(30.f)
+{
+    setupSquares();
+    setupPieceSprites();
+
+    highlight.setFillColor(sf::Color(100, 255, 100, 100));
+    highlight.setOrigin(30.f, 30.f);
+}
+
+// setup the board graphics
+void BoardRenderer::setupSquares()
+{
+    for (int row = 0; row < 8; ++row)
+    {
+        for (int col = 0; col < 8; ++col)
+        {
+            squares[row][col].setSize(sf::Vector2f(100.f, 100.f));
+            squares[row][col].setPosition(col * 100.f, row * 100.f);
+            if ((row + col) % 2 == 0)
+                squares[row][col].setFillColor(sf::Color::White);
+            else
+                squares[row][col].setFillColor(sf::Color(139, 69, 19));
+        }
+    }
+}
+
+// cut the piece sprites out of the piece texture
+void BoardRenderer::setupPieceSprites()
+{
+    sf::Texture &chessPiecesTexture = ResourceManager::getInstance().getTexture("assets/chess_pieces.png");
+
+    for (int color = 0; color < 2; ++color)
+    {
+        for (int type = 0; type < 6; ++type)
+        {
+            int textureCol = 0;
+            switch (static_cast<PieceType>(type))
+            {
+            case PieceType::King:
+                textureCol = 0;
+                break;
+            case PieceType::Queen:
+                textureCol = 1;
+                break;
+            case PieceType::Bishop:
+                textureCol = 2;
+                break;
+            case PieceType::Knight:
+                textureCol = 3;
+                break;
+            case PieceType::Rook:
+                textureCol = 4;
+                break;
+            case PieceType::Pawn:
+                textureCol = 5;
+                break;
+            }
+
+            int textureRow = (static_cast<PieceColor>(color) == PieceColor::White) ? 0 : 333;
+
+            sf::Sprite &sprite = pieceSprites[color][type];
+            sprite.setTexture(chessPiecesTexture);
+            sprite.setTextureRect(sf::IntRect(textureCol * 333, textureRow, 333, 333));
+            sprite.setScale(0.3f, 0.3f);
+        }
+    }
+}
+
+// draw the squares, the move hints and the pieces of the current position
+void BoardRenderer::draw(sf::RenderWindow &window, const Board &board, const MoveList &validMoves)
+{
+    for (int row = 0; row < 8; ++row)
+    {
+        for (int col = 0; col < 8; ++col)
+        {
+            window.draw(squares[row][col]);
+        }
+    }
+
+    for (const auto &move : validMoves)
+    {
+        // the four promotions of a pawn share one target square
+        if (move.isPromotion() && move.getPromotionType() != PieceType::Queen)
+            continue;
+
+        highlight.setPosition(move.getEndX() * 100.f + 50.f, move.getEndY() * 100.f + 50.f);
+        window.draw(highlight);
+    }
+
+    const Position &position = board.getPosition();
+    Bitboard occupied = position.getOccupied();
+    while (occupied)
+    {
+        int square = Bitboards::popLsb(occupied);
+        sf::Sprite &sprite = pieceSprites[static_cast<int>(position.getColorAt(square))][static_cast<int>(position.getTypeAt(square))];
+
+        sprite.setPosition(Bitboards::squareX(square) * 100.f, Bitboards::squareY(square) * 100.f);
+        window.draw(sprite);
+    }
+}
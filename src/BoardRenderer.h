@@ -0,0 +1,26 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Board.h"
+#include "ChessEngine/MoveList.h"
+#include "Types.h"
+
+// draws a board, the sprites and square shapes live here so the board itself stays plain data
+class BoardRenderer
+{
+public:
+    BoardRenderer();
+
+    // draw the squares, the move hints and the pieces of the current position
+    void draw(sf::RenderWindow &window, const Board &board, const MoveList &validMoves);
+
+private:
+    void setupSquares();
+    void setupPieceSprites();
+
+    sf::RectangleShape squares[8][8];
+
+    // one sprite per color and piece type, moved onto each occupied square while drawing
+    sf::Sprite pieceSprites[2][6];
+
+    sf::CircleShape highlight;
+};
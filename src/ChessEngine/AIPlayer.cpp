@@ -1,218 +1,483 @@
 #include "AIPlayer.h"
 #include "PieceSquareTables.h"
-#include <limits>
+#include "MoveGen.h"
+#include "MovePicker.h"
+#include "AllocationCounter.h"
 #include <algorithm>
-#include <unordered_map>
+#include <cstdlib>
 #include <iostream>
 #include "Utilities.h"
 
+namespace
+{
+    // piece values indexed by PieceType
+    const int pieceValues[6] = {20000, 900, 500, 330, 320, 100};
+
+    // positional swing a capture may still bring on top of the captured piece
+    const int DeltaMargin = 200;
+
+    // mate scores count plies from the root, the table stores them counted from the node instead
+    int scoreToTT(int score, int ply)
+    {
+        if (score >= AIPlayer::MateScore - AIPlayer::MaxPly)
+            return score + ply;
+        if (score <= -AIPlayer::MateScore + AIPlayer::MaxPly)
+            return score - ply;
+        return score;
+    }
+
+    int scoreFromTT(int score, int ply)
+    {
+        if (score >= AIPlayer::MateScore - AIPlayer::MaxPly)
+            return score - ply;
+        if (score <= -AIPlayer::MateScore + AIPlayer::MaxPly)
+            return score + ply;
+        return score;
+    }
+}
+
 // constructor
-AIPlayer::AIPlayer(PieceColor aiColor)
-    : aiColor_(aiColor), maxDepth_(3)
+AIPlayer::AIPlayer(PieceColor aiColor, std::size_t hashMegabytes)
+    : aiColor_(aiColor), timeLimit_(DefaultTimeLimitMs), nodes_(0), completedDepth_(0), stopped_(false),
+      tt_(hashMegabytes)
 {
 }
 
-// get best move for ai
-Move AIPlayer::getBestMove(Board &board, const std::pair<Piece *, std::pair<int, int>> &lastMove)
+// resize the transposition table, this clears it
+void AIPlayer::setHashSize(std::size_t megabytes)
 {
-    int bestValue = std::numeric_limits<int>::min();
-    Move bestMove;
+    tt_.resize(megabytes);
+}
 
-    auto possibleMoves = getAllPossibleMoves(board, aiColor_, lastMove);
+// wall-clock time a search may take, in milliseconds
+void AIPlayer::setTimeLimit(int milliseconds)
+{
+    timeLimit_ = std::chrono::milliseconds(milliseconds);
+}
 
-    for (auto &move : possibleMoves)
+// get best move for ai, the root moves are the legal moves the game already computed for this position
+Move AIPlayer::getBestMove(Board &board, const MoveList &legalMoves)
+{
+    // search on a private copy, the gui keeps drawing the live board
+    Board searchBoard = board;
+    Zobrist::Key rootKey = searchBoard.getPosition().getKey();
+
+    nodes_ = 0;
+    completedDepth_ = 0;
+    stopped_ = false;
+    searchStart_ = std::chrono::steady_clock::now();
+    for (auto &plyKillers : killers_)
+        plyKillers[0] = plyKillers[1] = Move();
+    tt_.newSearch();
+
+#ifndef NDEBUG
+    std::size_t allocationsBefore = AllocationCounter::getCount();
+#endif
+
+    MoveList rootMoves = legalMoves;
+    filterRootMoves(searchBoard.getPosition(), rootMoves);
+    if (rootMoves.empty())
+        return Move();
+
+    // the best move of an earlier search of this position goes first
+    Move bestMove = rootMoves[0];
+    int previousValue = 0;
+    TTData rootEntry;
+    if (tt_.probe(rootKey, rootEntry))
+        bestMove = rootEntry.move;
+
+    // iterative deepening, each iteration starts with the best move of the one before and an
+    // interrupted iteration is thrown away
+    for (int depth = 1; depth <= MaxDepth; ++depth)
     {
-        Board tempBoard = board;
-        Piece *tempPiece = tempBoard.getPieceAt(move.startX, move.startY);
-        bool isCastling = (move.pieceType == PieceType::King && std::abs(move.endX - move.startX) == 2);
-
-        tempBoard.movePiece(tempPiece, move.endX, move.endY, false, isCastling);
-
-        int moveValue = -negamax(tempBoard, maxDepth_ - 1, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), -1, lastMove);
+        auto best = std::find(rootMoves.begin(), rootMoves.end(), bestMove);
+        if (best != rootMoves.end())
+            std::rotate(rootMoves.begin(), best, best + 1);
+
+        // from the fourth iteration on, search a narrow window around the last score and widen the
+        // side that fails until the score falls inside
+        int alpha = -Infinity;
+        int beta = Infinity;
+        int delta = AspirationWindow;
+        if (depth >= 4)
+        {
+            alpha = std::max(previousValue - delta, -Infinity);
+            beta = std::min(previousValue + delta, Infinity);
+        }
 
-        if (moveValue > bestValue)
+        int value;
+        Move move;
+        while (true)
         {
-            bestValue = moveValue;
-            bestMove = move;
+            move = searchRoot(searchBoard, rootMoves, depth, alpha, beta, value);
+            if (stopped_)
+                break;
+
+            if (value <= alpha)
+                alpha = std::max(value - delta, -Infinity);
+            else if (value >= beta)
+                beta = std::min(value + delta, Infinity);
+            else
+                break;
+
+            delta *= 2;
         }
+        if (stopped_)
+            break;
+
+        previousValue = value;
+
+        bestMove = move;
+        completedDepth_ = depth;
+        tt_.store(rootKey, bestMove, scoreToTT(value, 0), depth, Bound::Exact);
+
+        // a forced mate does not change with more depth, and an iteration that cannot finish in the
+        // remaining time is not worth starting
+        if (std::abs(value) >= MateScore - MaxPly || (std::chrono::steady_clock::now() - searchStart_) * 2 > timeLimit_)
+            break;
     }
 
+#ifndef NDEBUG
+    std::cout << "depth " << completedDepth_ << ", searched " << nodes_ << " nodes with "
+              << AllocationCounter::getCount() - allocationsBefore << " heap allocations" << std::endl;
+#endif
+
     return bestMove;
 }
 
-// negamax algorithm with alpha-beta pruning
-int AIPlayer::negamax(Board &board, int depth, int alpha, int beta, int colorMultiplier, const std::pair<Piece *, std::pair<int, int>> &lastMove)
+// search every root move to a depth inside a window, sets value to the score of the best one
+Move AIPlayer::searchRoot(Board &board, const MoveList &rootMoves, int depth, int alpha, int beta, int &value)
 {
-    PieceColor currentColor = (colorMultiplier == 1) ? aiColor_ : (aiColor_ == PieceColor::White ? PieceColor::Black : PieceColor::White);
+    value = -Infinity;
+    Move bestMove;
 
-    if (depth == 0 || board.isInsufficientMaterial())
+    auto searchChild = [&](int childAlpha, int childBeta)
     {
-        return colorMultiplier * evaluateBoard(board);
-    }
+        return aiColor_ == PieceColor::White
+                   ? -negamax<PieceColor::Black>(board, depth - 1, childAlpha, childBeta, 1)
+                   : -negamax<PieceColor::White>(board, depth - 1, childAlpha, childBeta, 1);
+    };
 
-    if (!board.hasValidMoves(currentColor))
+    for (int i = 0; i < rootMoves.size(); ++i)
     {
-        if (board.isKingInCheck(currentColor))
+        UndoInfo undo = aiColor_ == PieceColor::White ? board.makeMove<PieceColor::White>(rootMoves[i])
+                                                      : board.makeMove<PieceColor::Black>(rootMoves[i]);
+
+        // the first move gets the full window, the others only have to prove they are not better
+        int moveValue;
+        if (i == 0)
         {
-            return -100000 + depth;
+            moveValue = searchChild(-beta, -alpha);
         }
         else
         {
-            return 0;
+            moveValue = searchChild(-alpha - 1, -alpha);
+            if (moveValue > alpha && moveValue < beta)
+                moveValue = searchChild(-beta, -alpha);
+        }
+
+        board.unmakeMove(rootMoves[i], undo);
+        if (stopped_)
+            break;
+
+        if (moveValue > value)
+        {
+            value = moveValue;
+            bestMove = rootMoves[i];
         }
+        alpha = std::max(alpha, value);
+        if (alpha >= beta)
+            break;
+    }
+
+    return bestMove;
+}
+
+// stop once the time is up, the first iteration always finishes so there is a move to play
+void AIPlayer::checkTime()
+{
+    if (completedDepth_ > 0 && std::chrono::steady_clock::now() - searchStart_ >= timeLimit_)
+        stopped_ = true;
+}
+
+// negamax algorithm with alpha-beta pruning
+template <PieceColor Us>
+int AIPlayer::negamax(Board &board, int depth, int alpha, int beta, int ply, bool allowNullMove)
+{
+    // the horizon is resolved by searching captures until the position is quiet
+    if (depth <= 0)
+        return quiescence<Us>(board, alpha, beta, ply);
+
+    int colorMultiplier = (Us == aiColor_) ? 1 : -1;
+
+    if ((++nodes_ & (TimeCheckInterval - 1)) == 0)
+        checkTime();
+    if (stopped_)
+        return 0;
+
+    if (board.isFiftyMoveDraw())
+        return 0;
+
+    if (board.isInsufficientMaterial())
+    {
+        return colorMultiplier * evaluateBoard(board);
     }
 
-    int maxEval = std::numeric_limits<int>::min();
-    auto possibleMoves = getAllPossibleMoves(board, currentColor, lastMove);
+    // a stored result that is deep enough and bounds the window ends the search here
+    const Position &position = board.getPosition();
+    Zobrist::Key key = position.getKey();
+    TTData ttData;
+    bool ttHit = tt_.probe(key, ttData);
+    if (ttHit && ttData.depth >= depth)
+    {
+        int ttScore = scoreFromTT(ttData.score, ply);
+        if (ttData.bound == Bound::Exact ||
+            (ttData.bound == Bound::Lower && ttScore >= beta) ||
+            (ttData.bound == Bound::Upper && ttScore <= alpha))
+            return ttScore;
+    }
 
-    // sort moves based on heuristic to improve pruning
-    sort(possibleMoves.begin(), possibleMoves.end(), [this](const Move &a, const Move &b)
-         {
-             int scoreA = moveOrderingHeuristic(a);
-             int scoreB = moveOrderingHeuristic(b);
-             return scoreA > scoreB; });
+    MoveGen::CheckInfo checkInfo = MoveGen::getCheckInfo<Us>(position);
 
-    for (auto &move : possibleMoves)
+    // null-move pruning, if passing the turn still fails high a real move will too. it is skipped in
+    // check, right after another null move, in windows that are not zero width and when the side to
+    // move has only pawns, where zugzwang makes passing better than any move
+    bool hasPieces = position.getPieceCount(Us, PieceType::Queen) || position.getPieceCount(Us, PieceType::Rook) ||
+                     position.getPieceCount(Us, PieceType::Bishop) || position.getPieceCount(Us, PieceType::Knight);
+    if (allowNullMove && depth >= NullMoveMinDepth && !checkInfo.checkers && beta - alpha == 1 &&
+        beta < MateScore - MaxPly && hasPieces)
     {
-        Board tempBoard = board;
-        Piece *tempPiece = tempBoard.getPieceAt(move.startX, move.startY);
-        if (!tempPiece)
+        int reduction = depth >= 7 ? 3 : 2;
+
+        // quiescence does not probe the table, so only children with depth left are prefetched
+        if (depth - 1 - reduction > 0)
+            tt_.prefetch(position.keyAfterNullMove());
+        UndoInfo undo = board.makeNullMove();
+        int nullValue = -negamax<oppositeColor(Us)>(board, depth - 1 - reduction, -beta, -beta + 1, ply + 1, false);
+        board.unmakeNullMove(undo);
+        if (stopped_)
+            return 0;
+
+        if (nullValue >= beta)
         {
+            // deep cutoffs are verified by a reduced search of this side's own moves without a null move
+            if (depth < NullMoveVerifyDepth ||
+                negamax<Us>(board, depth - 1 - reduction, beta - 1, beta, ply, false) >= beta)
+            {
+                // a mate found by passing is not proven
+                return nullValue >= MateScore - MaxPly ? beta : nullValue;
+            }
+            if (stopped_)
+                return 0;
+        }
+    }
+
+    int originalAlpha = alpha;
+    int maxEval = -Infinity;
+    Move bestMove;
+    int movesSearched = 0;
 
+    // moves come in stages, so a cutoff on an early move skips generating the rest, and
+    // legality is only tested for moves that are actually searched
+    MovePicker picker(position, ttHit ? ttData.move : Move(), killers_[std::min(ply, MaxPly - 1)]);
+    for (Move move = picker.nextMove(); !move.isNull(); move = picker.nextMove())
+    {
+        if (!MoveGen::isLegal<Us>(position, move, checkInfo))
             continue;
-        }
 
-        bool isCastling = false;
-        if (move.pieceType == PieceType::King && std::abs(move.endX - move.startX) == 2)
+        if (depth > 1)
+            tt_.prefetch(position.keyAfter<Us>(move));
+        UndoInfo undo = board.makeMove<Us>(move);
+
+        // principal variation search, after the first move a zero window test is enough unless
+        // the move turns out better than alpha
+        int eval;
+        if (movesSearched == 0)
         {
-            isCastling = true;
+            eval = -negamax<oppositeColor(Us)>(board, depth - 1, -beta, -alpha, ply + 1);
+        }
+        else
+        {
+            eval = -negamax<oppositeColor(Us)>(board, depth - 1, -alpha - 1, -alpha, ply + 1);
+            if (eval > alpha && eval < beta)
+                eval = -negamax<oppositeColor(Us)>(board, depth - 1, -beta, -alpha, ply + 1);
         }
 
-        tempBoard.movePiece(tempPiece, move.endX, move.endY, false, isCastling);
-
-        int eval = -negamax(tempBoard, depth - 1, -beta, -alpha, -colorMultiplier, lastMove);
+        board.unmakeMove(move, undo);
+        if (stopped_)
+            return 0;
+        ++movesSearched;
 
-        maxEval = std::max(maxEval, eval);
+        if (eval > maxEval)
+        {
+            maxEval = eval;
+            bestMove = move;
+        }
         alpha = std::max(alpha, eval);
 
         if (alpha >= beta)
+        {
+            if (!move.isCapture() && !move.isPromotion())
+                storeKiller(move, ply);
             break;
+        }
     }
 
+    if (movesSearched == 0)
+    {
+        if (checkInfo.checkers)
+        {
+            return -MateScore + ply;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    // a score at or below the original alpha is only an upper bound, and after a cutoff only a lower one
+    Bound bound = maxEval >= beta ? Bound::Lower : (maxEval <= originalAlpha ? Bound::Upper : Bound::Exact);
+    tt_.store(key, bound == Bound::Upper ? Move() : bestMove, scoreToTT(maxEval, ply), depth, bound);
+
     return maxEval;
 }
 
-// heuristic for ordering moves
-int AIPlayer::moveOrderingHeuristic(const Move &move)
+// search captures and promotions until the position is quiet, in check every evasion is searched
+template <PieceColor Us>
+int AIPlayer::quiescence(Board &board, int alpha, int beta, int ply)
 {
-    int score = 0;
+    int colorMultiplier = (Us == aiColor_) ? 1 : -1;
 
-    if (move.isCapture)
-        score += 1000;
+    if ((++nodes_ & (TimeCheckInterval - 1)) == 0)
+        checkTime();
+    if (stopped_)
+        return 0;
 
-    if (move.pieceType == PieceType::King && std::abs(move.endX - move.startX) == 2)
-        score += 900;
+    if (board.isFiftyMoveDraw())
+        return 0;
 
-    if (move.isPromotion)
-        score += 800;
+    const Position &position = board.getPosition();
+    MoveGen::CheckInfo checkInfo = MoveGen::getCheckInfo<Us>(position);
+    bool inCheck = checkInfo.checkers != 0;
 
-    return score;
-}
+    if (ply >= MaxPly - 1)
+        return colorMultiplier * evaluateBoard(board);
 
-// evaluate the board state
-int AIPlayer::evaluateBoard(const Board &board)
-{
-    int score = 0;
+    // the side to move may stand pat instead of capturing, unless it is in check
+    int standPat = 0;
+    int bestValue = -MateScore + ply;
+    if (!inCheck)
+    {
+        standPat = colorMultiplier * evaluateBoard(board);
+        if (standPat >= beta)
+            return standPat;
 
-    // define piece values
-    const std::unordered_map<PieceType, int> pieceValues = {
-        {PieceType::Pawn, 100},
-        {PieceType::Knight, 320},
-        {PieceType::Bishop, 330},
-        {PieceType::Rook, 500},
-        {PieceType::Queen, 900},
-        {PieceType::King, 20000}};
+        alpha = std::max(alpha, standPat);
+        bestValue = standPat;
+    }
 
-    for (const auto &piece : board.getPieces())
+    const Move noKillers[2];
+    MovePicker picker = inCheck ? MovePicker(position, Move(), noKillers) : MovePicker(position);
+    for (Move move = picker.nextMove(); !move.isNull(); move = picker.nextMove())
     {
-        int value = pieceValues.at(piece->getType());
-        int x = piece->getX();
-        int y = piece->getY();
-
-        if (piece->getColor() == PieceColor::Black)
+        // delta pruning, a capture that cannot lift the score near alpha even with a margin is skipped
+        // before paying for the legality test
+        if (!inCheck && !move.isPromotion())
         {
-            x = 7 - x;
-            y = 7 - y;
+            int captured = move.isEnPassant() ? static_cast<int>(PieceType::Pawn)
+                                              : static_cast<int>(position.getTypeAt(move.getTo()));
+            if (standPat + pieceValues[captured] + DeltaMargin <= alpha)
+                continue;
         }
 
-        int positionValue = 0;
+        if (!MoveGen::isLegal<Us>(position, move, checkInfo))
+            continue;
+
+        UndoInfo undo = board.makeMove<Us>(move);
 
-        // add positional value based on piece type
-        switch (piece->getType())
-        {
-        case PieceType::Pawn:
-            positionValue = PieceSquareTables::pawnTable[y][x];
-            break;
-        case PieceType::Knight:
-            positionValue = PieceSquareTables::knightTable[y][x];
-            break;
-        case PieceType::Bishop:
-            positionValue = PieceSquareTables::bishopTable[y][x];
-            break;
-        case PieceType::Rook:
-            positionValue = PieceSquareTables::rookTable[y][x];
-            break;
-        case PieceType::Queen:
-            positionValue = PieceSquareTables::queenTable[y][x];
-            break;
-        case PieceType::King:
-            positionValue = PieceSquareTables::kingTable[y][x];
-            break;
-        }
+        int eval = -quiescence<oppositeColor(Us)>(board, -beta, -alpha, ply + 1);
 
-        if (piece->getColor() == aiColor_)
-        {
-            score += value + positionValue;
-        }
-        else
+        board.unmakeMove(move, undo);
+        if (stopped_)
+            return 0;
+
+        if (eval > bestValue)
         {
-            score -= value + positionValue;
+            bestValue = eval;
+            alpha = std::max(alpha, eval);
+            if (alpha >= beta)
+                break;
         }
+    }
 
-        if (piece->getType() == PieceType::King)
+    return bestValue;
+}
+
+// remember a quiet move that caused a cutoff, it is tried early in sibling nodes
+void AIPlayer::storeKiller(const Move &move, int ply)
+{
+    if (ply >= MaxPly || killers_[ply][0] == move)
+        return;
+
+    killers_[ply][1] = killers_[ply][0];
+    killers_[ply][0] = move;
+}
+
+// evaluate the board state
+int AIPlayer::evaluateBoard(const Board &board)
+{
+    int score = 0;
+    const Position &position = board.getPosition();
+
+    const int (*const pieceTables[6])[8] = {
+        PieceSquareTables::kingTable,
+        PieceSquareTables::queenTable,
+        PieceSquareTables::rookTable,
+        PieceSquareTables::bishopTable,
+        PieceSquareTables::knightTable,
+        PieceSquareTables::pawnTable};
+
+    for (PieceColor color : {PieceColor::White, PieceColor::Black})
+    {
+        int sign = (color == aiColor_) ? 1 : -1;
+
+        for (int type = 0; type < 6; ++type)
         {
-            if (!piece->hasMoved())
+            const std::uint8_t *squares = position.getPieceSquares(color, static_cast<PieceType>(type));
+            for (int i = 0, count = position.getPieceCount(color, static_cast<PieceType>(type)); i < count; ++i)
             {
-                if (piece->getColor() == aiColor_)
-                {
-                    score -= 30;
-                }
-                else
+                int square = squares[i];
+                int x = Bitboards::squareX(square);
+                int y = Bitboards::squareY(square);
+
+                if (color == PieceColor::Black)
                 {
-                    score += 30;
+                    x = 7 - x;
+                    y = 7 - y;
                 }
+
+                score += sign * (pieceValues[type] + pieceTables[type][y][x]);
             }
         }
+
         // adjust score based on king's movement
-        if (piece->getType() == PieceType::King)
+        int kingSquare = position.getKingSquare(color);
+        if (kingSquare == NoSquare)
+            continue;
+
+        if (!hasKingMoved(position, color))
         {
-            if (piece->hasMoved())
-            {
-                int kingX = piece->getX();
-                int kingY = piece->getY();
+            score -= sign * 30;
+        }
+        else
+        {
+            int kingX = Bitboards::squareX(kingSquare);
+            int kingY = Bitboards::squareY(kingSquare);
 
-                bool castledPosition = (kingX == 6 || kingX == 2) && (kingY == 0 || kingY == 7);
-                if (castledPosition)
-                {
-                    if (piece->getColor() == aiColor_)
-                    {
-                        score += 50;
-                    }
-                    else
-                    {
-                        score -= 50;
-                    }
-                }
+            bool castledPosition = (kingX == 6 || kingX == 2) && (kingY == 0 || kingY == 7);
+            if (castledPosition)
+            {
+                score += sign * 50;
             }
         }
     }
@@ -224,70 +489,58 @@ int AIPlayer::evaluateBoard(const Board &board)
     return score;
 }
 
+// the king counts as unmoved while it is on its home square and can still castle
+bool AIPlayer::hasKingMoved(const Position &position, PieceColor color)
+{
+    int homeSquare = (color == PieceColor::White) ? Bitboards::makeSquare(4, 7) : Bitboards::makeSquare(4, 0);
+    int rights = (color == PieceColor::White) ? WhiteCastling : BlackCastling;
+
+    return position.getKingSquare(color) != homeSquare || !(position.getCastlingRights() & rights);
+}
+
 // evaluates king safety based on position, cover, pawn structure
 int AIPlayer::evaluateKingSafety(const Board &board, PieceColor color)
 {
     int safetyScore = 0;
-    Piece *king = nullptr;
+    const Position &position = board.getPosition();
 
-    for (const auto &piece : board.getPieces())
-    {
-        if (piece->getType() == PieceType::King && piece->getColor() == color)
-        {
-            king = piece.get();
-            break;
-        }
-    }
-
-    if (!king)
+    int kingSquare = position.getKingSquare(color);
+    if (kingSquare == NoSquare)
         return safetyScore;
 
-    int kingX = king->getX();
-    int kingY = king->getY();
+    int kingY = Bitboards::squareY(kingSquare);
 
     if (kingY < 2 || kingY > 5)
         safetyScore += 20;
     else
         safetyScore -= 20;
 
-    if (!king->hasMoved())
+    if (!hasKingMoved(position, color))
         safetyScore -= 50;
 
     return safetyScore;
 }
 
-// returns a vector of all possible moves a piece can make
-std::vector<Move> AIPlayer::getAllPossibleMoves(Board &board, PieceColor color, const std::pair<Piece *, std::pair<int, int>> &lastMove)
+// drop root moves the ai should not consider
+void AIPlayer::filterRootMoves(const Position &position, MoveList &moves)
 {
-    std::vector<Move> moves;
-    for (const auto &piece : board.getPieces())
+    // while the king can still castle to a side, do not waste a tempo stepping towards it
+    if (!hasKingMoved(position, aiColor_))
     {
-        if (piece->getColor() == color)
+        bool castleLeft = false, castleRight = false;
+        int kingSquare = position.getKingSquare(aiColor_);
+        for (const auto &move : moves)
         {
-            auto validMoves = board.getValidMoves(piece.get(), lastMove);
-            for (const auto &move : validMoves)
-            {
-                if (piece->getType() == PieceType::King && !piece->hasMoved())
-                {
-                    int dx = move.first - piece->getX();
-                    int dy = move.second - piece->getY();
-
-                    if (dy == 0 && std::abs(dx) == 1)
-                    {
-                        if (board.canCastle(color, dx > 0))
-                            continue;
-                    }
-                }
-                Move m;
-                m.startX = piece->getX();
-                m.startY = piece->getY();
-                m.endX = move.first;
-                m.endY = move.second;
-                m.pieceType = piece->getType();
-                m.pieceColor = piece->getColor();
-                moves.push_back(m);
-            }
+            if (move.getFlags() == Move::KingCastle)
+                castleRight = true;
+            if (move.getFlags() == Move::QueenCastle)
+                castleLeft = true;
         }
+
+        moves.erase(std::remove_if(moves.begin(), moves.end(), [&](const Move &move)
+                                   { return move.getFrom() == kingSquare && !move.isCastle() &&
+                                            ((move.getTo() - kingSquare == 1 && castleRight) ||
+                                             (move.getTo() - kingSquare == -1 && castleLeft)); }),
+                    moves.end());
     }
-    return moves;
-}
\ No newline at end of file
+}
@@ -1,42 +1,86 @@
 #pragma once
+#include <chrono>
 #include "Board.h"
 #include "Types.h"
-
-struct Move
-{
-    int startX, startY;
-    int endX, endY;
-    PieceType pieceType;
-    PieceColor pieceColor;
-    bool isPromotion;
-    bool isCapture;
-};
-
-struct TTEntry
-{
-    int depth;
-    int value;
-    int flag;
-};
+#include "Move.h"
+#include "MoveList.h"
+#include "TranspositionTable.h"
 
 class AIPlayer
 {
 public:
-    AIPlayer(PieceColor aiColor);
+    static constexpr std::size_t DefaultHashMegabytes = 16;
+    static constexpr int DefaultTimeLimitMs = 1000;
+
+    AIPlayer(PieceColor aiColor, std::size_t hashMegabytes = DefaultHashMegabytes);
 
-    Move getBestMove(Board &board, const std::pair<Piece *, std::pair<int, int>> &lastMove);
+    // resize the transposition table, this clears it
+    void setHashSize(std::size_t megabytes);
+
+    // wall-clock time a search may take, in milliseconds
+    void setTimeLimit(int milliseconds);
+
+    // legalMoves are the legal moves of the position, as computed by Board::computeGameStatus
+    Move getBestMove(Board &board, const MoveList &legalMoves);
+
+    // being mated n plies from the root scores -MateScore + n
+    static constexpr int MateScore = 100000;
+
+    // bound of every search window, above any score
+    static constexpr int Infinity = MateScore + 1;
+
+    static constexpr int MaxPly = 64;
 
 private:
+    // iterative deepening stops here even if time is left
+    static constexpr int MaxDepth = 32;
+
+    // half width of the first aspiration window around the previous iteration's score
+    static constexpr int AspirationWindow = 50;
+
+    // null-move pruning needs this much depth left, and from the verify depth on a cutoff is checked
+    // by a reduced search before it is trusted
+    static constexpr int NullMoveMinDepth = 3;
+    static constexpr int NullMoveVerifyDepth = 6;
+
+    // the clock is read once per this many nodes, must be a power of two
+    static constexpr long long TimeCheckInterval = 2048;
+
     PieceColor aiColor_;
-    int maxDepth_;
+    std::chrono::milliseconds timeLimit_;
+    std::chrono::steady_clock::time_point searchStart_;
 
-    int negamax(Board &board, int depth, int alpha, int beta, int colorMultiplier, const std::pair<Piece *, std::pair<int, int>> &lastMove);
+    // nodes visited by the current search
+    long long nodes_;
 
-    int evaluateBoard(const Board &board);
+    // deepest finished iteration, and whether the current one ran out of time
+    int completedDepth_;
+    bool stopped_;
+
+    // two quiet moves per ply that last caused a beta cutoff
+    Move killers_[MaxPly][2];
+
+    // results of earlier searches, kept between moves
+    TranspositionTable tt_;
+
+    // the side to move is a template parameter, so each node picks its color-specific code once
+    template <PieceColor Us>
+    int negamax(Board &board, int depth, int alpha, int beta, int ply, bool allowNullMove = true);
 
-    std::vector<Move> getAllPossibleMoves(Board &board, PieceColor color, const std::pair<Piece *, std::pair<int, int>> &lastMove);
+    template <PieceColor Us>
+    int quiescence(Board &board, int alpha, int beta, int ply);
 
-    int moveOrderingHeuristic(const Move &move);
+    Move searchRoot(Board &board, const MoveList &rootMoves, int depth, int alpha, int beta, int &value);
+
+    void checkTime();
+
+    void storeKiller(const Move &move, int ply);
+
+    int evaluateBoard(const Board &board);
+
+    void filterRootMoves(const Position &position, MoveList &moves);
 
     int evaluateKingSafety(const Board &board, PieceColor color);
+
+    static bool hasKingMoved(const Position &position, PieceColor color);
 };
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+
+// counts global operator new calls per thread in debug builds, release builds always report zero
+namespace AllocationCounter
+{
+    std::size_t getCount();
+}
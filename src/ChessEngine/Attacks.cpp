@@ -0,0 +1,234 @@
+#include "Attacks.h"
+#include <stdexcept>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+namespace
+{
+    // walk each direction until the edge of the board or the first blocker
+    Bitboard slidingAttacks(int square, Bitboard occupied, const int (*directions)[2])
+    {
+        Bitboard attacks = 0;
+        int file = Bitboards::fileOf(square);
+        int rank = Bitboards::rankOf(square);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            int f = file + directions[i][0];
+            int r = rank + directions[i][1];
+
+            while (f >= 0 && f <= 7 && r >= 0 && r <= 7)
+            {
+                Bitboard target = Bitboards::squareBB(r * 8 + f);
+                attacks |= target;
+                if (occupied & target)
+                    break;
+                f += directions[i][0];
+                r += directions[i][1];
+            }
+        }
+
+        return attacks;
+    }
+
+    const int rookDirections[4][2] = {
+        {0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+
+    const int bishopDirections[4][2] = {
+        {1, 1}, {1, -1}, {-1, -1}, {-1, 1}};
+
+    // every blocker configuration of every square shares one table per slider type
+    Bitboard rookTable[0x19000];
+    Bitboard bishopTable[0x1480];
+
+    // xorshift64* generator, seeded so the same magics are found on every run
+    struct Random
+    {
+        Bitboard state;
+
+        Bitboard next()
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 2685821657736338717ULL;
+        }
+
+        // magics with few set bits are found much faster
+        Bitboard sparse() { return next() & next() & next(); }
+    };
+
+    Attacks::SliderBackend activeBackend = Attacks::SliderBackend::Magic;
+
+    void initMagics(Attacks::Magic *magics, Bitboard *table, const int (*directions)[2], bool usePext)
+    {
+        Bitboard occupancy[4096];
+        Bitboard reference[4096];
+        int epoch[4096] = {};
+        int attempt = 0;
+
+        // seeds per rank that are known to find every magic within a few thousand tries
+        const Bitboard seeds[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+
+        Bitboard *next = table;
+
+        for (int square = 0; square < 64; ++square)
+        {
+            Attacks::Magic &m = magics[square];
+
+            // board edges never change the attack set unless the slider stands on them
+            Bitboard edges = ((Bitboards::Rank1 | Bitboards::Rank8) & ~(Bitboards::Rank1 << (8 * Bitboards::rankOf(square)))) |
+                             ((Bitboards::FileA | Bitboards::FileH) & ~(Bitboards::FileA << Bitboards::fileOf(square)));
+
+            m.mask = slidingAttacks(square, 0, directions) & ~edges;
+            m.shift = 64 - Bitboards::popCount(m.mask);
+            m.attacks = next;
+
+            // enumerate every subset of the mask with the carry-rippler trick
+            int size = 0;
+            Bitboard subset = 0;
+            do
+            {
+                occupancy[size] = subset;
+                reference[size] = slidingAttacks(square, subset, directions);
+                ++size;
+                subset = (subset - m.mask) & m.mask;
+            } while (subset);
+
+            next += size;
+
+            // pext indexes the subsets directly, there is no magic to search for
+            if (usePext)
+            {
+#if defined(__x86_64__)
+                for (int i = 0; i < size; ++i)
+                    m.attacks[Bitboards::pext(occupancy[i], m.mask)] = reference[i];
+#endif
+                continue;
+            }
+
+            Random random{seeds[Bitboards::rankOf(square)]};
+            for (int i = 0; i < size;)
+            {
+                do
+                {
+                    m.magic = random.sparse();
+                } while (Bitboards::popCount((m.magic * m.mask) >> 56) < 6);
+
+                ++attempt;
+                for (i = 0; i < size; ++i)
+                {
+                    unsigned index = m.index(occupancy[i]);
+
+                    if (epoch[index] < attempt)
+                    {
+                        epoch[index] = attempt;
+                        m.attacks[index] = reference[i];
+                    }
+                    else if (m.attacks[index] != reference[i])
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+namespace Attacks
+{
+    bool pextEnabled = false;
+
+    Magic rookMagics[64];
+    Magic bishopMagics[64];
+
+    // build the slider attack tables, must run once at startup before any attack lookup
+    void init(SliderBackend backend)
+    {
+        if (backend == SliderBackend::Auto)
+            backend = cpuHasFastPext() ? SliderBackend::Pext : SliderBackend::Magic;
+
+        if (backend == SliderBackend::Pext && !cpuSupportsBmi2())
+            throw std::runtime_error("The pext slider backend needs a cpu with bmi2.");
+
+        // the flag changes how tables are indexed, so it has to be set before they are filled
+        activeBackend = backend;
+        pextEnabled = backend == SliderBackend::Pext;
+
+        initMagics(rookMagics, rookTable, rookDirections, pextEnabled);
+        initMagics(bishopMagics, bishopTable, bishopDirections, pextEnabled);
+    }
+
+    SliderBackend getSliderBackend()
+    {
+        return activeBackend;
+    }
+
+    const char *sliderBackendName(SliderBackend backend)
+    {
+        switch (backend)
+        {
+        case SliderBackend::Auto:
+            return "auto";
+        case SliderBackend::Magic:
+            return "magic";
+        case SliderBackend::Pext:
+            return "pext";
+        }
+        return "unknown";
+    }
+
+    SliderBackend parseSliderBackend(const std::string &value)
+    {
+        if (value == "auto")
+            return SliderBackend::Auto;
+        if (value == "magic")
+            return SliderBackend::Magic;
+        if (value == "pext")
+            return SliderBackend::Pext;
+
+        throw std::invalid_argument("Unknown slider backend: " + value);
+    }
+
+    bool cpuSupportsBmi2()
+    {
+#if defined(__x86_64__)
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            return false;
+        return (ebx & (1u << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    // bmi2 is present and pext is not microcoded (amd before zen 3)
+    bool cpuHasFastPext()
+    {
+        if (!cpuSupportsBmi2())
+            return false;
+
+#if defined(__x86_64__)
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        __get_cpuid(0, &eax, &ebx, &ecx, &edx);
+
+        // "AuthenticAMD" split over ebx, edx, ecx
+        bool isAmd = ebx == 0x68747541 && edx == 0x69746E65 && ecx == 0x444D4163;
+        if (isAmd)
+        {
+            __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+            unsigned family = (eax >> 8) & 0xF;
+            if (family == 0xF)
+                family += (eax >> 20) & 0xFF;
+
+            // zen 1 and zen 2 are family 17h, zen 3 starts at 19h
+            return family >= 0x19;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+}
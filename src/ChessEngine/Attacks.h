@@ -0,0 +1,185 @@
+#pragma once
+
+#include <string>
+#include "Bitboard.h"
+#include "Types.h"
+
+// attack sets for each piece type on a bitboard position
+namespace Attacks
+{
+    // how slider attack tables are indexed
+    enum class SliderBackend
+    {
+        Auto,
+        Magic,
+        Pext
+    };
+
+    // set by init when the pext backend is selected
+    extern bool pextEnabled;
+
+    // slider table entry for one square, indexed by magic multiply or by pext
+    struct Magic
+    {
+        Bitboard mask;
+        Bitboard magic;
+        Bitboard *attacks;
+        unsigned shift;
+
+        unsigned index(Bitboard occupied) const
+        {
+#if defined(__x86_64__)
+            if (pextEnabled)
+                return static_cast<unsigned>(Bitboards::pext(occupied, mask));
+#endif
+            return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+        }
+    };
+
+    extern Magic rookMagics[64];
+    extern Magic bishopMagics[64];
+
+    // build the slider attack tables, must run once at startup before any attack lookup
+    // auto picks pext on cpus where it is fast and falls back to magics everywhere else
+    void init(SliderBackend backend = SliderBackend::Auto);
+
+    // the backend chosen by init
+    SliderBackend getSliderBackend();
+
+    const char *sliderBackendName(SliderBackend backend);
+
+    // the backend named by a --slider-backend value (auto, magic or pext), throws on anything else
+    SliderBackend parseSliderBackend(const std::string &value);
+
+    bool cpuSupportsBmi2();
+
+    // bmi2 is present and pext is not microcoded (amd before zen 3)
+    bool cpuHasFastPext();
+
+    // leaper and pawn attacks for every square, built at compile time
+    struct LeaperTables
+    {
+        Bitboard knight[64];
+        Bitboard king[64];
+        Bitboard pawn[2][64];
+    };
+
+    constexpr LeaperTables generateLeaperTables()
+    {
+        LeaperTables tables{};
+
+        for (int square = 0; square < 64; ++square)
+        {
+            Bitboard b = Bitboards::squareBB(square);
+
+            Bitboard east = Bitboards::eastOne(b);
+            Bitboard west = Bitboards::westOne(b);
+            Bitboard knight = (east | west) << 16 | (east | west) >> 16;
+            east = Bitboards::eastOne(east);
+            west = Bitboards::westOne(west);
+            tables.knight[square] = knight | (east | west) << 8 | (east | west) >> 8;
+
+            Bitboard row = b | Bitboards::eastOne(b) | Bitboards::westOne(b);
+            tables.king[square] = (row | Bitboards::northOne(row) | Bitboards::southOne(row)) & ~b;
+
+            Bitboard north = Bitboards::northOne(b);
+            Bitboard south = Bitboards::southOne(b);
+            tables.pawn[static_cast<int>(PieceColor::White)][square] = Bitboards::eastOne(north) | Bitboards::westOne(north);
+            tables.pawn[static_cast<int>(PieceColor::Black)][square] = Bitboards::eastOne(south) | Bitboards::westOne(south);
+        }
+
+        return tables;
+    }
+
+    inline constexpr LeaperTables leaperTables = generateLeaperTables();
+
+    constexpr Bitboard knightAttacks(int square) { return leaperTables.knight[square]; }
+    constexpr Bitboard kingAttacks(int square) { return leaperTables.king[square]; }
+    constexpr Bitboard pawnAttacks(PieceColor color, int square) { return leaperTables.pawn[static_cast<int>(color)][square]; }
+
+    // color-templated pawn helpers, the direction of each shift is fixed at compile time
+    template <PieceColor C>
+    constexpr Bitboard pawnAttacks(int square) { return leaperTables.pawn[static_cast<int>(C)][square]; }
+
+    // every pawn of a color one step forward
+    template <PieceColor C>
+    constexpr Bitboard pawnPushes(Bitboard pawns)
+    {
+        return C == PieceColor::White ? Bitboards::northOne(pawns) : Bitboards::southOne(pawns);
+    }
+
+    // squares a set of pawns of a color attacks towards the h-file and towards the a-file
+    template <PieceColor C>
+    constexpr Bitboard pawnAttacksEast(Bitboard pawns) { return Bitboards::eastOne(pawnPushes<C>(pawns)); }
+
+    template <PieceColor C>
+    constexpr Bitboard pawnAttacksWest(Bitboard pawns) { return Bitboards::westOne(pawnPushes<C>(pawns)); }
+
+    static_assert(knightAttacks(0) == 0x20400ULL && kingAttacks(0) == 0x302ULL, "leaper tables are built at compile time");
+
+    // for every pair of squares on a shared rank, file or diagonal: the squares strictly between them
+    // and the whole line through both from edge to edge, both are empty for unaligned pairs
+    struct LineTables
+    {
+        Bitboard between[64][64];
+        Bitboard line[64][64];
+    };
+
+    constexpr LineTables generateLineTables()
+    {
+        LineTables tables{};
+        const int directions[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, -1}, {1, -1}, {-1, 1}};
+
+        for (int from = 0; from < 64; ++from)
+        {
+            for (int d = 0; d < 8; ++d)
+            {
+                // a direction and its opposite are neighbours in the list
+                Bitboard fullLine = Bitboards::squareBB(from);
+                for (int side = d - d % 2; side <= d - d % 2 + 1; ++side)
+                {
+                    int file = Bitboards::fileOf(from) + directions[side][0];
+                    int rank = Bitboards::rankOf(from) + directions[side][1];
+                    for (; file >= 0 && file < 8 && rank >= 0 && rank < 8; file += directions[side][0], rank += directions[side][1])
+                        fullLine |= Bitboards::squareBB(rank * 8 + file);
+                }
+
+                Bitboard between = 0;
+                int file = Bitboards::fileOf(from) + directions[d][0];
+                int rank = Bitboards::rankOf(from) + directions[d][1];
+                for (; file >= 0 && file < 8 && rank >= 0 && rank < 8; file += directions[d][0], rank += directions[d][1])
+                {
+                    int to = rank * 8 + file;
+                    tables.between[from][to] = between;
+                    tables.line[from][to] = fullLine;
+                    between |= Bitboards::squareBB(to);
+                }
+            }
+        }
+
+        return tables;
+    }
+
+    inline constexpr LineTables lineTables = generateLineTables();
+
+    constexpr Bitboard between(int a, int b) { return lineTables.between[a][b]; }
+    constexpr Bitboard line(int a, int b) { return lineTables.line[a][b]; }
+
+    // sliding attacks stop at (and include) the first blocker in each direction
+    inline Bitboard rookAttacks(int square, Bitboard occupied)
+    {
+        const Magic &m = rookMagics[square];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard bishopAttacks(int square, Bitboard occupied)
+    {
+        const Magic &m = bishopMagics[square];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard queenAttacks(int square, Bitboard occupied)
+    {
+        return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+using Bitboard = std::uint64_t;
+
+constexpr int NoSquare = -1;
+
+// squares are numbered a1 = 0 ... h8 = 63, the gui uses x = file and y = row from the top
+namespace Bitboards
+{
+    constexpr Bitboard FileA = 0x0101010101010101ULL;
+    constexpr Bitboard FileB = FileA << 1;
+    constexpr Bitboard FileG = FileA << 6;
+    constexpr Bitboard FileH = FileA << 7;
+    constexpr Bitboard Rank1 = 0xFFULL;
+    constexpr Bitboard Rank2 = Rank1 << 8;
+    constexpr Bitboard Rank3 = Rank1 << 16;
+    constexpr Bitboard Rank4 = Rank1 << 24;
+    constexpr Bitboard Rank5 = Rank1 << 32;
+    constexpr Bitboard Rank6 = Rank1 << 40;
+    constexpr Bitboard Rank7 = Rank1 << 48;
+    constexpr Bitboard Rank8 = Rank1 << 56;
+    constexpr Bitboard LightSquares = 0x55AA55AA55AA55AAULL;
+
+    // convert gui coordinates to a square index
+    constexpr int makeSquare(int x, int y) { return (7 - y) * 8 + x; }
+
+    // get the gui column of a square
+    constexpr int squareX(int square) { return square & 7; }
+
+    // get the gui row of a square
+    constexpr int squareY(int square) { return 7 - (square >> 3); }
+
+    constexpr int fileOf(int square) { return square & 7; }
+    constexpr int rankOf(int square) { return square >> 3; }
+
+    constexpr Bitboard squareBB(int square) { return Bitboard(1) << square; }
+
+    constexpr Bitboard northOne(Bitboard b) { return b << 8; }
+    constexpr Bitboard southOne(Bitboard b) { return b >> 8; }
+    constexpr Bitboard eastOne(Bitboard b) { return (b & ~FileH) << 1; }
+    constexpr Bitboard westOne(Bitboard b) { return (b & ~FileA) >> 1; }
+
+    inline int popCount(Bitboard b) { return __builtin_popcountll(b); }
+
+    // index of the least significant set bit, b must be non-zero
+    inline int lsb(Bitboard b) { return __builtin_ctzll(b); }
+
+    // remove and return the least significant set bit
+    inline int popLsb(Bitboard &b)
+    {
+        int square = lsb(b);
+        b &= b - 1;
+        return square;
+    }
+
+#if defined(__x86_64__)
+    // bmi2 parallel bit extract, only call this after checking the cpu supports it
+    inline Bitboard pext(Bitboard b, Bitboard mask)
+    {
+        Bitboard result;
+        asm("pextq %2, %1, %0" : "=r"(result) : "r"(b), "r"(mask));
+        return result;
+    }
+#endif
+
+}
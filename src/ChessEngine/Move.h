@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include "Types.h"
+#include "Bitboard.h"
+
+// move packed into 16 bits: 6 bits start square, 6 bits end square, 4 bits flags
+class Move
+{
+public:
+    // the capture bit is 4 and the promotion bit is 8, the low two bits pick the promotion piece
+    enum Flags : int
+    {
+        Quiet = 0,
+        DoublePawnPush = 1,
+        KingCastle = 2,
+        QueenCastle = 3,
+        Capture = 4,
+        EnPassant = 5,
+        KnightPromotion = 8,
+        BishopPromotion = 9,
+        RookPromotion = 10,
+        QueenPromotion = 11,
+        KnightPromotionCapture = 12,
+        BishopPromotionCapture = 13,
+        RookPromotionCapture = 14,
+        QueenPromotionCapture = 15
+    };
+
+    // the null move, never generated because its start and end square are equal
+    constexpr Move() : data_(0) {}
+
+    constexpr Move(int from, int to, int flags = Quiet)
+        : data_(static_cast<std::uint16_t>(from | (to << 6) | (flags << 12))) {}
+
+    constexpr int getFrom() const { return data_ & 0x3F; }
+    constexpr int getTo() const { return (data_ >> 6) & 0x3F; }
+    constexpr int getFlags() const { return data_ >> 12; }
+
+    constexpr bool isCapture() const { return (getFlags() & Capture) != 0; }
+    constexpr bool isPromotion() const { return (getFlags() & KnightPromotion) != 0; }
+    constexpr bool isEnPassant() const { return getFlags() == EnPassant; }
+    constexpr bool isCastle() const { return getFlags() == KingCastle || getFlags() == QueenCastle; }
+    constexpr bool isDoublePawnPush() const { return getFlags() == DoublePawnPush; }
+
+    // piece a pawn promotes to, only meaningful for promotions
+    constexpr PieceType getPromotionType() const
+    {
+        constexpr PieceType types[4] = {PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen};
+        return types[getFlags() & 3];
+    }
+
+    // gui coordinates of the start and end square
+    constexpr int getStartX() const { return Bitboards::squareX(getFrom()); }
+    constexpr int getStartY() const { return Bitboards::squareY(getFrom()); }
+    constexpr int getEndX() const { return Bitboards::squareX(getTo()); }
+    constexpr int getEndY() const { return Bitboards::squareY(getTo()); }
+
+    constexpr bool isNull() const { return data_ == 0; }
+
+    constexpr std::uint16_t getData() const { return data_; }
+
+    constexpr bool operator==(const Move &other) const { return data_ == other.data_; }
+    constexpr bool operator!=(const Move &other) const { return data_ != other.data_; }
+
+private:
+    std::uint16_t data_;
+};
+
+static_assert(sizeof(Move) == 2, "moves must stay packed into 16 bits");
@@ -0,0 +1,472 @@
+#include "MoveGen.h"
+#include "Attacks.h"
+#include "pieces/King.h"
+#include "pieces/Queen.h"
+#include "pieces/Rook.h"
+#include "pieces/Bishop.h"
+#include "pieces/Knight.h"
+#include "pieces/Pawn.h"
+
+// every generator is compiled once per color, so pawn directions and home ranks are constants
+namespace
+{
+    void addMoves(const Position &position, int from, Bitboard targets, MoveList &moves)
+    {
+        PieceType type = position.getTypeAt(from);
+
+        while (targets)
+        {
+            int to = Bitboards::popLsb(targets);
+            int flags = position.isEmpty(to) ? Move::Quiet : Move::Capture;
+
+            if (type == PieceType::Pawn && (Bitboards::rankOf(to) == 0 || Bitboards::rankOf(to) == 7))
+            {
+                for (int promotion = Move::QueenPromotion; promotion >= Move::KnightPromotion; --promotion)
+                    moves.push_back(Move(from, to, flags | promotion));
+                continue;
+            }
+
+            if (type == PieceType::Pawn && (to - from == 16 || from - to == 16))
+                flags = Move::DoublePawnPush;
+
+            moves.push_back(Move(from, to, flags));
+        }
+    }
+
+    // pawn moves to a set of end squares that all lie the same offset away from their start square
+    void addPawnMoves(Bitboard targets, int offset, int flags, MoveList &moves)
+    {
+        while (targets)
+        {
+            int to = Bitboards::popLsb(targets);
+            moves.push_back(Move(to - offset, to, flags));
+        }
+    }
+
+    void addPromotions(Bitboard targets, int offset, int flags, MoveList &moves)
+    {
+        while (targets)
+        {
+            int to = Bitboards::popLsb(targets);
+            for (int promotion = Move::QueenPromotion; promotion >= Move::KnightPromotion; --promotion)
+                moves.push_back(Move(to - offset, to, flags | promotion));
+        }
+    }
+
+    // moves of a set of pawns generated with whole-board shifts, only end squares in allowed are kept
+    template <PieceColor Us>
+    void generatePawnMoves(const Position &position, Bitboard pawns, Bitboard allowed, MoveGen::GenType type, MoveList &moves)
+    {
+        constexpr int Up = Us == PieceColor::White ? 8 : -8;
+        constexpr Bitboard DoublePushRank = Us == PieceColor::White ? Bitboards::Rank3 : Bitboards::Rank6;
+        constexpr Bitboard PromotionRank = Us == PieceColor::White ? Bitboards::Rank8 : Bitboards::Rank1;
+
+        Bitboard empty = ~position.getOccupied();
+        Bitboard enemies = position.getPieces(oppositeColor(Us)) & allowed;
+
+        Bitboard singlePushes = Attacks::pawnPushes<Us>(pawns) & empty;
+        Bitboard doublePushes = Attacks::pawnPushes<Us>(singlePushes & DoublePushRank) & empty & allowed;
+        singlePushes &= allowed;
+
+        Bitboard eastCaptures = Attacks::pawnAttacksEast<Us>(pawns) & enemies;
+        Bitboard westCaptures = Attacks::pawnAttacksWest<Us>(pawns) & enemies;
+
+        // captures include every promotion
+        if (type != MoveGen::GenType::Quiets)
+        {
+            addPromotions(eastCaptures & PromotionRank, Up + 1, Move::Capture, moves);
+            addPromotions(westCaptures & PromotionRank, Up - 1, Move::Capture, moves);
+            addPromotions(singlePushes & PromotionRank, Up, Move::Quiet, moves);
+            addPawnMoves(eastCaptures & ~PromotionRank, Up + 1, Move::Capture, moves);
+            addPawnMoves(westCaptures & ~PromotionRank, Up - 1, Move::Capture, moves);
+        }
+
+        if (type != MoveGen::GenType::Captures)
+        {
+            addPawnMoves(doublePushes, Up + Up, Move::DoublePawnPush, moves);
+            addPawnMoves(singlePushes & ~PromotionRank, Up, Move::Quiet, moves);
+        }
+    }
+
+    // squares the piece on a square attacks or can push to, before pins and checks are applied
+    template <PieceColor Us>
+    Bitboard pieceTargets(const Position &position, int from)
+    {
+        switch (position.getTypeAt(from))
+        {
+        case PieceType::Pawn:
+            return Pawn::getTargets<Us>(position, from);
+        case PieceType::Knight:
+            return Knight::getTargets(position, from, Us);
+        case PieceType::Bishop:
+            return Bishop::getTargets(position, from, Us);
+        case PieceType::Rook:
+            return Rook::getTargets(position, from, Us);
+        case PieceType::Queen:
+            return Queen::getTargets(position, from, Us);
+        case PieceType::King:
+            return King::getTargets(position, from, Us);
+        }
+        return 0;
+    }
+
+    // target masks for one kind of move, promotions count as captures
+    template <PieceColor Us>
+    void getTargetFilters(const Position &position, MoveGen::GenType type, Bitboard &pieceFilter, Bitboard &pawnFilter)
+    {
+        constexpr Bitboard PromotionRank = Us == PieceColor::White ? Bitboards::Rank8 : Bitboards::Rank1;
+        Bitboard enemies = position.getPieces(oppositeColor(Us));
+
+        pieceFilter = ~Bitboard(0);
+        pawnFilter = ~Bitboard(0);
+        if (type == MoveGen::GenType::Captures)
+        {
+            pieceFilter = enemies;
+            pawnFilter = enemies | PromotionRank;
+        }
+        else if (type == MoveGen::GenType::Quiets)
+        {
+            pieceFilter = ~enemies;
+            pawnFilter = ~enemies & ~PromotionRank;
+        }
+    }
+
+    // en passant removes two pieces from the board, so it is verified against the resulting occupancy
+    template <PieceColor Us>
+    bool isEnPassantLegal(const Position &position, int from, int kingSquare)
+    {
+        constexpr int Up = Us == PieceColor::White ? 8 : -8;
+        int enPassantSquare = position.getEnPassantSquare();
+        int capturedSquare = enPassantSquare - Up;
+        Bitboard after = (position.getOccupied() ^ Bitboards::squareBB(from) ^ Bitboards::squareBB(capturedSquare)) |
+                         Bitboards::squareBB(enPassantSquare);
+
+        return !(position.getAttackersTo(kingSquare, after) & position.getPieces(oppositeColor(Us)) &
+                 ~Bitboards::squareBB(capturedSquare));
+    }
+
+    template <PieceColor Us>
+    bool canCastle(const Position &position, int kingSquare, bool isKingSide)
+    {
+        constexpr bool IsWhite = Us == PieceColor::White;
+        constexpr int HomeSquare = IsWhite ? 4 : 60;
+        int right = isKingSide ? (IsWhite ? WhiteKingSide : BlackKingSide) : (IsWhite ? WhiteQueenSide : BlackQueenSide);
+        int rookSquare = isKingSide ? HomeSquare + 3 : HomeSquare - 4;
+
+        if (!(position.getCastlingRights() & right) || kingSquare != HomeSquare ||
+            !(position.getPieces(Us, PieceType::Rook) & Bitboards::squareBB(rookSquare)))
+            return false;
+
+        Bitboard occupied = position.getOccupied();
+        if (Attacks::between(HomeSquare, rookSquare) & occupied)
+            return false;
+
+        // the king may not pass through or land on an attacked square
+        int step = isKingSide ? 1 : -1;
+        for (int i = 1; i <= 2; ++i)
+        {
+            if (position.isAttackedBy<oppositeColor(Us)>(HomeSquare + i * step, occupied))
+                return false;
+        }
+
+        return true;
+    }
+
+    template <PieceColor Us>
+    void generateLegalMoves(const Position &position, MoveList &moves, MoveGen::GenType type, bool canCaptureEnPassant)
+    {
+        constexpr PieceColor Them = oppositeColor(Us);
+        int kingSquare = position.getKingSquare(Us);
+        if (kingSquare == NoSquare)
+            return;
+
+        Bitboard own = position.getPieces(Us);
+        Bitboard occupied = position.getOccupied();
+        Bitboard checkers = position.getAttackersTo(kingSquare, occupied) & position.getPieces(Them);
+
+        // captures land on enemy pieces, quiet moves on empty squares
+        Bitboard pieceFilter, pawnFilter;
+        getTargetFilters<Us>(position, type, pieceFilter, pawnFilter);
+
+        // the king steps to squares that stay safe once it has left its current square
+        Bitboard kingTargets = King::getTargets(position, kingSquare, Us) & pieceFilter;
+        Bitboard withoutKing = occupied & ~Bitboards::squareBB(kingSquare);
+        Bitboard safeTargets = 0;
+        while (kingTargets)
+        {
+            int to = Bitboards::popLsb(kingTargets);
+            if (!position.isAttackedBy<Them>(to, withoutKing))
+                safeTargets |= Bitboards::squareBB(to);
+        }
+        addMoves(position, kingSquare, safeTargets, moves);
+
+        // in double check only the king can move
+        if (Bitboards::popCount(checkers) > 1)
+            return;
+
+        // other pieces must capture the checker or block its line
+        Bitboard checkMask = ~Bitboard(0);
+        if (checkers)
+        {
+            checkMask = checkers | Attacks::between(kingSquare, Bitboards::lsb(checkers));
+        }
+        else if (type != MoveGen::GenType::Captures)
+        {
+            if (canCastle<Us>(position, kingSquare, true))
+                moves.push_back(Move(kingSquare, kingSquare + 2, Move::KingCastle));
+            if (canCastle<Us>(position, kingSquare, false))
+                moves.push_back(Move(kingSquare, kingSquare - 2, Move::QueenCastle));
+        }
+
+        // a piece alone between the king and an enemy slider may only move along that line
+        Bitboard pinned = 0;
+        Bitboard pinRays[64];
+        Bitboard queens = position.getPieces(Them, PieceType::Queen);
+        Bitboard snipers = (Attacks::rookAttacks(kingSquare, 0) & (position.getPieces(Them, PieceType::Rook) | queens)) |
+                           (Attacks::bishopAttacks(kingSquare, 0) & (position.getPieces(Them, PieceType::Bishop) | queens));
+        while (snipers)
+        {
+            int sniper = Bitboards::popLsb(snipers);
+            Bitboard between = Attacks::between(kingSquare, sniper);
+            Bitboard blockers = between & occupied;
+
+            if (Bitboards::popCount(blockers) == 1 && (blockers & own))
+            {
+                pinned |= blockers;
+                pinRays[Bitboards::lsb(blockers)] = between | Bitboards::squareBB(sniper);
+            }
+        }
+
+        // pawns that are not pinned move all at once, pinned pawns go through the per-piece loop
+        Bitboard pawns = position.getPieces(Us, PieceType::Pawn);
+        generatePawnMoves<Us>(position, pawns & ~pinned, checkMask, type, moves);
+
+        Bitboard pieces = (own & ~pawns & ~Bitboards::squareBB(kingSquare)) | (pawns & pinned);
+        while (pieces)
+        {
+            int from = Bitboards::popLsb(pieces);
+            Bitboard targets = pieceTargets<Us>(position, from);
+            targets &= position.getTypeAt(from) == PieceType::Pawn ? pawnFilter : pieceFilter;
+            targets &= checkMask;
+            if (pinned & Bitboards::squareBB(from))
+                targets &= pinRays[from];
+
+            addMoves(position, from, targets, moves);
+        }
+
+        int enPassantSquare = position.getEnPassantSquare();
+        if (enPassantSquare != NoSquare && canCaptureEnPassant && type != MoveGen::GenType::Quiets)
+        {
+            Bitboard capturers = Attacks::pawnAttacks<Them>(enPassantSquare) & pawns;
+
+            while (capturers)
+            {
+                int from = Bitboards::popLsb(capturers);
+                if (isEnPassantLegal<Us>(position, from, kingSquare))
+                    moves.push_back(Move(from, enPassantSquare, Move::EnPassant));
+            }
+        }
+    }
+
+    template <PieceColor Us>
+    void generatePseudoLegalMoves(const Position &position, MoveList &moves, MoveGen::GenType type)
+    {
+        int kingSquare = position.getKingSquare(Us);
+
+        Bitboard pieceFilter, pawnFilter;
+        getTargetFilters<Us>(position, type, pieceFilter, pawnFilter);
+
+        Bitboard pawns = position.getPieces(Us, PieceType::Pawn);
+        generatePawnMoves<Us>(position, pawns, ~Bitboard(0), type, moves);
+
+        Bitboard pieces = position.getPieces(Us) & ~pawns;
+        while (pieces)
+        {
+            int from = Bitboards::popLsb(pieces);
+            addMoves(position, from, pieceTargets<Us>(position, from) & pieceFilter, moves);
+        }
+
+        if (type != MoveGen::GenType::Captures && kingSquare != NoSquare &&
+            !position.isAttackedBy<oppositeColor(Us)>(kingSquare, position.getOccupied()))
+        {
+            if (canCastle<Us>(position, kingSquare, true))
+                moves.push_back(Move(kingSquare, kingSquare + 2, Move::KingCastle));
+            if (canCastle<Us>(position, kingSquare, false))
+                moves.push_back(Move(kingSquare, kingSquare - 2, Move::QueenCastle));
+        }
+
+        int enPassantSquare = position.getEnPassantSquare();
+        if (enPassantSquare != NoSquare && type != MoveGen::GenType::Quiets)
+        {
+            Bitboard capturers = Attacks::pawnAttacks<oppositeColor(Us)>(enPassantSquare) & pawns;
+            while (capturers)
+                moves.push_back(Move(Bitboards::popLsb(capturers), enPassantSquare, Move::EnPassant));
+        }
+    }
+
+    template <PieceColor Us>
+    bool isPseudoLegal(const Position &position, const Move &move)
+    {
+        constexpr int Up = Us == PieceColor::White ? 8 : -8;
+        constexpr int LastRank = Us == PieceColor::White ? 7 : 0;
+        int from = move.getFrom();
+        int to = move.getTo();
+
+        // a capture bit on a castling flag (6 and 7) is not a move any generator emits
+        if (move.getFlags() == (Move::Capture | Move::KingCastle) || move.getFlags() == (Move::Capture | Move::QueenCastle))
+            return false;
+
+        if (position.isEmpty(from) || position.getColorAt(from) != Us)
+            return false;
+
+        PieceType type = position.getTypeAt(from);
+        bool isPawn = type == PieceType::Pawn;
+
+        if (move.isCastle())
+        {
+            bool isKingSide = move.getFlags() == Move::KingCastle;
+            if (type != PieceType::King || to != (isKingSide ? from + 2 : from - 2) ||
+                position.isAttackedBy<oppositeColor(Us)>(from, position.getOccupied()) ||
+                !canCastle<Us>(position, from, isKingSide))
+                return false;
+        }
+        else if (move.isEnPassant())
+        {
+            if (!isPawn || to != position.getEnPassantSquare() ||
+                !(Attacks::pawnAttacks<Us>(from) & Bitboards::squareBB(to)))
+                return false;
+        }
+        else
+        {
+            // the flags must describe what the move does in this position
+            bool reachesLastRank = isPawn && Bitboards::rankOf(to) == LastRank;
+            bool isDoublePush = isPawn && to - from == Up + Up;
+
+            if (move.isCapture() == position.isEmpty(to) || move.isPromotion() != reachesLastRank ||
+                move.isDoublePawnPush() != isDoublePush)
+                return false;
+
+            if (!(pieceTargets<Us>(position, from) & Bitboards::squareBB(to)))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+namespace MoveGen
+{
+    // append the legal moves of a color of one kind, only the side to move may capture en passant
+    void generateLegalMoves(const Position &position, PieceColor us, MoveList &moves, GenType type)
+    {
+        bool canCaptureEnPassant = position.getSideToMove() == us;
+        if (us == PieceColor::White)
+            ::generateLegalMoves<PieceColor::White>(position, moves, type, canCaptureEnPassant);
+        else
+            ::generateLegalMoves<PieceColor::Black>(position, moves, type, canCaptureEnPassant);
+    }
+
+    template <PieceColor Us>
+    CheckInfo getCheckInfo(const Position &position)
+    {
+        constexpr PieceColor Them = oppositeColor(Us);
+
+        CheckInfo info;
+        info.kingSquare = position.getKingSquare(Us);
+        info.checkers = 0;
+        info.pinned = 0;
+        if (info.kingSquare == NoSquare)
+            return info;
+
+        Bitboard occupied = position.getOccupied();
+        info.checkers = position.getAttackersTo(info.kingSquare, occupied) & position.getPieces(Them);
+
+        Bitboard queens = position.getPieces(Them, PieceType::Queen);
+        Bitboard snipers = (Attacks::rookAttacks(info.kingSquare, 0) & (position.getPieces(Them, PieceType::Rook) | queens)) |
+                           (Attacks::bishopAttacks(info.kingSquare, 0) & (position.getPieces(Them, PieceType::Bishop) | queens));
+        while (snipers)
+        {
+            Bitboard blockers = Attacks::between(info.kingSquare, Bitboards::popLsb(snipers)) & occupied;
+            if (Bitboards::popCount(blockers) == 1)
+                info.pinned |= blockers & position.getPieces(Us);
+        }
+
+        return info;
+    }
+
+    template CheckInfo getCheckInfo<PieceColor::White>(const Position &position);
+    template CheckInfo getCheckInfo<PieceColor::Black>(const Position &position);
+
+    CheckInfo getCheckInfo(const Position &position)
+    {
+        if (position.getSideToMove() == PieceColor::White)
+            return getCheckInfo<PieceColor::White>(position);
+        return getCheckInfo<PieceColor::Black>(position);
+    }
+
+    // append the moves of the side to move that obey piece movement but may leave the king attacked
+    void generatePseudoLegalMoves(const Position &position, MoveList &moves, GenType type)
+    {
+        if (position.getSideToMove() == PieceColor::White)
+            ::generatePseudoLegalMoves<PieceColor::White>(position, moves, type);
+        else
+            ::generatePseudoLegalMoves<PieceColor::Black>(position, moves, type);
+    }
+
+    template <PieceColor Us>
+    bool isLegal(const Position &position, const Move &move, const CheckInfo &info)
+    {
+        int from = move.getFrom();
+        int to = move.getTo();
+
+        // castling was fully checked when it was generated
+        if (move.isCastle())
+            return true;
+
+        if (from == info.kingSquare)
+            return !position.isAttackedBy<oppositeColor(Us)>(to, position.getOccupied() ^ Bitboards::squareBB(from));
+
+        if (move.isEnPassant())
+            return isEnPassantLegal<Us>(position, from, info.kingSquare);
+
+        // other pieces must capture the checker or block its line, and never escape a double check
+        if (info.checkers)
+        {
+            if (Bitboards::popCount(info.checkers) > 1)
+                return false;
+
+            Bitboard checkMask = info.checkers | Attacks::between(info.kingSquare, Bitboards::lsb(info.checkers));
+            if (!(checkMask & Bitboards::squareBB(to)))
+                return false;
+        }
+
+        // a pinned piece stays on the line through its king
+        if (info.pinned & Bitboards::squareBB(from))
+        {
+            return (Attacks::line(info.kingSquare, from) & Bitboards::squareBB(to)) != 0;
+        }
+
+        return true;
+    }
+
+    template bool isLegal<PieceColor::White>(const Position &position, const Move &move, const CheckInfo &info);
+    template bool isLegal<PieceColor::Black>(const Position &position, const Move &move, const CheckInfo &info);
+
+    bool isLegal(const Position &position, const Move &move, const CheckInfo &info)
+    {
+        if (position.getSideToMove() == PieceColor::White)
+            return isLegal<PieceColor::White>(position, move, info);
+        return isLegal<PieceColor::Black>(position, move, info);
+    }
+
+    // check whether a move could have been generated by generatePseudoLegalMoves
+    bool isPseudoLegal(const Position &position, const Move &move)
+    {
+        if (move.isNull())
+            return false;
+
+        if (position.getSideToMove() == PieceColor::White)
+            return ::isPseudoLegal<PieceColor::White>(position, move);
+        return ::isPseudoLegal<PieceColor::Black>(position, move);
+    }
+}
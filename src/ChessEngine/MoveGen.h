@@ -0,0 +1,53 @@
+#pragma once
+
+#include "MoveList.h"
+#include "Position.h"
+
+// legal move generation driven by checkers, pins and a check evasion mask, and a
+// pseudo-legal mode for the search that leaves the pin and check test to isLegal
+namespace MoveGen
+{
+    // which moves to generate, captures include every promotion
+    enum class GenType
+    {
+        All,
+        Captures,
+        Quiets
+    };
+
+    // append the legal moves of a color of one kind, only the side to move may capture en passant
+    void generateLegalMoves(const Position &position, PieceColor us, MoveList &moves, GenType type = GenType::All);
+
+    // checkers and pinned pieces of the side to move, computed once per node for isLegal
+    struct CheckInfo
+    {
+        int kingSquare;
+        Bitboard checkers;
+        Bitboard pinned;
+    };
+
+    CheckInfo getCheckInfo(const Position &position);
+
+    // the same for a side to move known at compile time, lets the search pick the color once per node
+    template <PieceColor Us>
+    CheckInfo getCheckInfo(const Position &position);
+
+    // append the moves of the side to move that obey piece movement but may leave the king attacked,
+    // castling is fully checked here
+    void generatePseudoLegalMoves(const Position &position, MoveList &moves, GenType type = GenType::All);
+
+    // check whether a pseudo-legal move of the side to move keeps its king safe
+    bool isLegal(const Position &position, const Move &move, const CheckInfo &info);
+
+    template <PieceColor Us>
+    bool isLegal(const Position &position, const Move &move, const CheckInfo &info);
+
+    extern template CheckInfo getCheckInfo<PieceColor::White>(const Position &position);
+    extern template CheckInfo getCheckInfo<PieceColor::Black>(const Position &position);
+    extern template bool isLegal<PieceColor::White>(const Position &position, const Move &move, const CheckInfo &info);
+    extern template bool isLegal<PieceColor::Black>(const Position &position, const Move &move, const CheckInfo &info);
+
+    // check whether a move could have been generated by generatePseudoLegalMoves, used for
+    // moves that come from elsewhere like the hash move and killers
+    bool isPseudoLegal(const Position &position, const Move &move);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include "Move.h"
+
+// fixed-capacity move list stored inline, so generating moves never touches the heap
+class MoveList
+{
+public:
+    // no legal chess position has more than 218 moves
+    static constexpr int Capacity = 256;
+
+    void push_back(const Move &move)
+    {
+        assert(size_ < Capacity);
+        moves_[size_++] = move;
+    }
+
+    void clear() { size_ = 0; }
+
+    // remove the moves in [first, last), shifting the rest down
+    void erase(Move *first, Move *last)
+    {
+        Move *newEnd = std::copy(last, end(), first);
+        size_ = static_cast<int>(newEnd - begin());
+    }
+
+    int size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    Move &operator[](int index) { return moves_[index]; }
+    const Move &operator[](int index) const { return moves_[index]; }
+
+    Move *begin() { return moves_; }
+    Move *end() { return moves_ + size_; }
+    const Move *begin() const { return moves_; }
+    const Move *end() const { return moves_ + size_; }
+
+private:
+    Move moves_[Capacity];
+    int size_ = 0;
+};
@@ -0,0 +1,148 @@
+#include "MovePicker.h"
+#include "MoveGen.h"
+#include <algorithm>
+
+namespace
+{
+    // piece values indexed by PieceType, a king is never captured
+    const int pieceValues[6] = {0, 900, 500, 330, 320, 100};
+}
+
+MovePicker::MovePicker(const Position &position, Move ttMove, const Move killers[2])
+    : position_(position), ttMove_(ttMove), killers_{killers[0], killers[1]},
+      stage_(Stage::TTMove), capturesOnly_(false), killerIndex_(0), current_(0)
+{
+}
+
+// captures and promotions only, for the quiescence search
+MovePicker::MovePicker(const Position &position)
+    : position_(position), ttMove_(), killers_{Move(), Move()},
+      stage_(Stage::GenerateCaptures), capturesOnly_(true), killerIndex_(0), current_(0)
+{
+}
+
+// next move to search, or a null move once every stage is done
+Move MovePicker::nextMove()
+{
+    switch (stage_)
+    {
+    case Stage::TTMove:
+        stage_ = Stage::GenerateCaptures;
+        if (MoveGen::isPseudoLegal(position_, ttMove_))
+            return ttMove_;
+        [[fallthrough]];
+
+    case Stage::GenerateCaptures:
+        moves_.clear();
+        MoveGen::generatePseudoLegalMoves(position_, moves_, MoveGen::GenType::Captures);
+        scoreCaptures();
+        current_ = 0;
+        stage_ = Stage::Captures;
+        [[fallthrough]];
+
+    case Stage::Captures:
+        while (current_ < moves_.size())
+        {
+            Move move = pickBest();
+            if (move != ttMove_)
+                return move;
+        }
+        if (capturesOnly_)
+        {
+            stage_ = Stage::Done;
+            break;
+        }
+        stage_ = Stage::Killers;
+        [[fallthrough]];
+
+    case Stage::Killers:
+        while (killerIndex_ < 2)
+        {
+            Move killer = killers_[killerIndex_++];
+            if (killerIndex_ == 2 && killer == killers_[0])
+                continue;
+
+            if (killer != ttMove_ && !killer.isCapture() && !killer.isPromotion() &&
+                MoveGen::isPseudoLegal(position_, killer))
+                return killer;
+        }
+        stage_ = Stage::GenerateQuiets;
+        [[fallthrough]];
+
+    case Stage::GenerateQuiets:
+        moves_.clear();
+        MoveGen::generatePseudoLegalMoves(position_, moves_, MoveGen::GenType::Quiets);
+
+        // castling is usually worth looking at before other quiet moves
+        std::partition(moves_.begin(), moves_.end(), [](const Move &move)
+                       { return move.isCastle(); });
+        current_ = 0;
+        stage_ = Stage::Quiets;
+        [[fallthrough]];
+
+    case Stage::Quiets:
+        while (current_ < moves_.size())
+        {
+            Move move = moves_[current_++];
+            if (!isAlreadyPicked(move))
+                return move;
+        }
+        stage_ = Stage::Done;
+        [[fallthrough]];
+
+    case Stage::Done:
+        break;
+    }
+
+    return Move();
+}
+
+// most valuable victim first, cheapest attacker breaks ties, promotions add the new piece
+void MovePicker::scoreCaptures()
+{
+    for (int i = 0; i < moves_.size(); ++i)
+    {
+        const Move &move = moves_[i];
+        int attacker = pieceValues[static_cast<int>(position_.getTypeAt(move.getFrom()))];
+        int victim = 0;
+
+        if (move.isEnPassant())
+            victim = pieceValues[static_cast<int>(PieceType::Pawn)];
+        else if (move.isCapture())
+            victim = pieceValues[static_cast<int>(position_.getTypeAt(move.getTo()))];
+
+        scores_[i] = victim * 10 - attacker / 10;
+        if (move.isPromotion())
+            scores_[i] += pieceValues[static_cast<int>(move.getPromotionType())] * 10;
+    }
+}
+
+// take the highest scored move that is left
+Move MovePicker::pickBest()
+{
+    int best = current_;
+    for (int i = current_ + 1; i < moves_.size(); ++i)
+    {
+        if (scores_[i] > scores_[best])
+            best = i;
+    }
+
+    std::swap(moves_[current_], moves_[best]);
+    std::swap(scores_[current_], scores_[best]);
+    return moves_[current_++];
+}
+
+// the hash move and killers are returned by their own stages
+bool MovePicker::isAlreadyPicked(const Move &move) const
+{
+    if (move == ttMove_)
+        return true;
+
+    // only killers that passed validation were returned
+    for (int i = 0; i < killerIndex_; ++i)
+    {
+        if (move == killers_[i])
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Move.h"
+#include "MoveList.h"
+#include "Position.h"
+
+// hands out the pseudo-legal moves of a position in stages, later stages are only generated when
+// they are reached and legality is left to the search
+class MovePicker
+{
+public:
+    // the hash move and killers may be null or from another position, they are checked before being returned
+    MovePicker(const Position &position, Move ttMove, const Move killers[2]);
+
+    // captures and promotions only, for the quiescence search
+    explicit MovePicker(const Position &position);
+
+    // next move to search, or a null move once every stage is done
+    Move nextMove();
+
+private:
+    enum class Stage
+    {
+        TTMove,
+        GenerateCaptures,
+        Captures,
+        Killers,
+        GenerateQuiets,
+        Quiets,
+        Done
+    };
+
+    void scoreCaptures();
+
+    // take the highest scored move that is left
+    Move pickBest();
+
+    // the hash move and killers are returned by their own stages
+    bool isAlreadyPicked(const Move &move) const;
+
+    const Position &position_;
+    Move ttMove_;
+    Move killers_[2];
+    Stage stage_;
+    bool capturesOnly_;
+    int killerIndex_;
+
+    MoveList moves_;
+    int scores_[MoveList::Capacity];
+    int current_;
+};
@@ -0,0 +1,480 @@
+#include "Position.h"
+#include "Attacks.h"
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+// constructor
+Position::Position()
+{
+    clear();
+}
+
+// remove all pieces and reset the state
+void Position::clear()
+{
+    for (auto &colorPieces : pieces_)
+        for (auto &bb : colorPieces)
+            bb = 0;
+
+    occupancy_[0] = occupancy_[1] = 0;
+
+    for (auto &colorCounts : pieceCounts_)
+        for (auto &count : colorCounts)
+            count = 0;
+
+    for (auto &square : board_)
+        square = NoPiece;
+
+    kingSquares_[0] = kingSquares_[1] = NoSquare;
+
+    sideToMove_ = PieceColor::White;
+    castlingRights_ = NoCastling;
+    enPassantSquare_ = NoSquare;
+    halfmoveClock_ = 0;
+
+    // an empty board with white to move and no rights hashes to zero
+    key_ = 0;
+    pawnKey_ = 0;
+    materialKey_ = 0;
+}
+
+// set up the standard starting position
+void Position::setStartPosition()
+{
+    clear();
+
+    const PieceType backRank[8] = {
+        PieceType::Rook, PieceType::Knight, PieceType::Bishop, PieceType::Queen,
+        PieceType::King, PieceType::Bishop, PieceType::Knight, PieceType::Rook};
+
+    for (int file = 0; file < 8; ++file)
+    {
+        putPiece(PieceColor::White, backRank[file], file);
+        putPiece(PieceColor::White, PieceType::Pawn, 8 + file);
+        putPiece(PieceColor::Black, PieceType::Pawn, 48 + file);
+        putPiece(PieceColor::Black, backRank[file], 56 + file);
+    }
+
+    setCastlingRights(AllCastling);
+}
+
+// set up a position from forsyth-edwards notation, throws std::invalid_argument if it is malformed
+void Position::setFromFen(const std::string &fen)
+{
+    std::istringstream stream(fen);
+    std::string placement, side, castling = "-", enPassant = "-";
+    int halfmoves = 0;
+
+    if (!(stream >> placement >> side))
+        throw std::invalid_argument("FEN needs at least a piece placement and a side to move: " + fen);
+    stream >> castling >> enPassant >> halfmoves;
+
+    clear();
+
+    int rank = 7;
+    int file = 0;
+    for (char c : placement)
+    {
+        if (c == '/')
+        {
+            if (file != 8 || rank == 0)
+                throw std::invalid_argument("Bad rank in FEN: " + fen);
+            --rank;
+            file = 0;
+        }
+        else if (c >= '1' && c <= '8')
+        {
+            file += c - '0';
+        }
+        else
+        {
+            const std::string symbols = "kqrbnp";
+            std::size_t type = symbols.find(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+            if (type == std::string::npos || file > 7)
+                throw std::invalid_argument("Bad piece placement in FEN: " + fen);
+
+            PieceColor color = std::isupper(static_cast<unsigned char>(c)) ? PieceColor::White : PieceColor::Black;
+            if (getPieceCount(color, static_cast<PieceType>(type)) == MaxPiecesPerType)
+                throw std::invalid_argument("Too many pieces of one kind in FEN: " + fen);
+            putPiece(color, static_cast<PieceType>(type), rank * 8 + file);
+            ++file;
+        }
+
+        if (file > 8)
+            throw std::invalid_argument("Bad rank in FEN: " + fen);
+    }
+
+    if (rank != 0 || file != 8)
+        throw std::invalid_argument("FEN must describe eight full ranks: " + fen);
+
+    if (side != "w" && side != "b")
+        throw std::invalid_argument("Bad side to move in FEN: " + fen);
+    setSideToMove(side == "w" ? PieceColor::White : PieceColor::Black);
+
+    int rights = NoCastling;
+    for (char c : castling)
+    {
+        switch (c)
+        {
+        case 'K':
+            rights |= WhiteKingSide;
+            break;
+        case 'Q':
+            rights |= WhiteQueenSide;
+            break;
+        case 'k':
+            rights |= BlackKingSide;
+            break;
+        case 'q':
+            rights |= BlackQueenSide;
+            break;
+        case '-':
+            break;
+        default:
+            throw std::invalid_argument("Bad castling rights in FEN: " + fen);
+        }
+    }
+    setCastlingRights(rights);
+
+    if (enPassant != "-")
+    {
+        if (enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' || (enPassant[1] != '3' && enPassant[1] != '6'))
+            throw std::invalid_argument("Bad en passant square in FEN: " + fen);
+
+        // recorded like makeMove does, only when a pawn can actually capture
+        int square = (enPassant[1] - '1') * 8 + (enPassant[0] - 'a');
+        PieceColor them = oppositeColor(sideToMove_);
+        if (Attacks::pawnAttacks(them, square) & getPieces(sideToMove_, PieceType::Pawn))
+            setEnPassantSquare(square);
+    }
+
+    halfmoveClock_ = halfmoves;
+}
+
+void Position::putPiece(PieceColor color, PieceType type, int square)
+{
+    int c = static_cast<int>(color);
+    int t = static_cast<int>(type);
+    Bitboard b = Bitboards::squareBB(square);
+
+    pieces_[c][t] |= b;
+    occupancy_[c] |= b;
+    board_[square] = static_cast<std::int8_t>(c * 6 + t);
+
+    key_ ^= Zobrist::keys.pieces[c][t][square];
+    if (type == PieceType::Pawn)
+        pawnKey_ ^= Zobrist::keys.pieces[c][t][square];
+
+    // append the square to the piece list and cache it if the piece is a king
+    pieceIndex_[square] = pieceCounts_[c][t];
+    pieceLists_[c][t][pieceCounts_[c][t]] = static_cast<std::uint8_t>(square);
+    if (type == PieceType::King)
+        kingSquares_[c] = static_cast<std::int8_t>(pieceLists_[c][t][0]);
+
+    // the material key hashes the nth piece of a type with the key of square n
+    materialKey_ ^= Zobrist::keys.pieces[c][t][pieceCounts_[c][t]++];
+}
+
+void Position::removePiece(int square)
+{
+    if (isEmpty(square))
+        return;
+
+    int c = board_[square] / 6;
+    int t = board_[square] % 6;
+    Bitboard b = Bitboards::squareBB(square);
+
+    pieces_[c][t] &= ~b;
+    occupancy_[c] &= ~b;
+    board_[square] = NoPiece;
+
+    key_ ^= Zobrist::keys.pieces[c][t][square];
+    if (t == static_cast<int>(PieceType::Pawn))
+        pawnKey_ ^= Zobrist::keys.pieces[c][t][square];
+
+    materialKey_ ^= Zobrist::keys.pieces[c][t][--pieceCounts_[c][t]];
+
+    // the last piece of the list fills the gap
+    int last = pieceLists_[c][t][pieceCounts_[c][t]];
+    pieceIndex_[last] = pieceIndex_[square];
+    pieceLists_[c][t][pieceIndex_[square]] = static_cast<std::uint8_t>(last);
+    if (t == static_cast<int>(PieceType::King))
+        kingSquares_[c] = pieceCounts_[c][t] ? static_cast<std::int8_t>(pieceLists_[c][t][0]) : NoSquare;
+}
+
+// move a piece without any rule handling, the destination must be empty
+void Position::relocatePiece(int from, int to)
+{
+    int c = board_[from] / 6;
+    int t = board_[from] % 6;
+    Bitboard fromTo = Bitboards::squareBB(from) | Bitboards::squareBB(to);
+
+    pieces_[c][t] ^= fromTo;
+    occupancy_[c] ^= fromTo;
+    board_[to] = board_[from];
+    board_[from] = NoPiece;
+
+    pieceIndex_[to] = pieceIndex_[from];
+    pieceLists_[c][t][pieceIndex_[to]] = static_cast<std::uint8_t>(to);
+    if (t == static_cast<int>(PieceType::King))
+        kingSquares_[c] = static_cast<std::int8_t>(pieceLists_[c][t][0]);
+
+    Zobrist::Key moveKey = Zobrist::keys.pieces[c][t][from] ^ Zobrist::keys.pieces[c][t][to];
+    key_ ^= moveKey;
+    if (t == static_cast<int>(PieceType::Pawn))
+        pawnKey_ ^= moveKey;
+}
+
+void Position::setSideToMove(PieceColor color)
+{
+    if (color != sideToMove_)
+        key_ ^= Zobrist::keys.blackToMove;
+    sideToMove_ = color;
+}
+
+void Position::setCastlingRights(int rights)
+{
+    key_ ^= Zobrist::keys.castling[castlingRights_] ^ Zobrist::keys.castling[rights];
+    castlingRights_ = rights;
+}
+
+void Position::setEnPassantSquare(int square)
+{
+    if (enPassantSquare_ != NoSquare)
+        key_ ^= Zobrist::keys.enPassantFile[Bitboards::fileOf(enPassantSquare_)];
+    if (square != NoSquare)
+        key_ ^= Zobrist::keys.enPassantFile[Bitboards::fileOf(square)];
+    enPassantSquare_ = square;
+}
+
+// play a move in place, castling, en passant and promotion come from the move flags
+void Position::makeMove(const Move &move, UndoInfo &undo)
+{
+    if (getColorAt(move.getFrom()) == PieceColor::White)
+        makeMove<PieceColor::White>(move, undo);
+    else
+        makeMove<PieceColor::Black>(move, undo);
+}
+
+template <PieceColor Us>
+void Position::makeMove(const Move &move, UndoInfo &undo)
+{
+    constexpr PieceColor Them = oppositeColor(Us);
+    constexpr int Up = Us == PieceColor::White ? 8 : -8;
+    int from = move.getFrom();
+    int to = move.getTo();
+    bool isPawnMove = getTypeAt(from) == PieceType::Pawn;
+
+    undo.castlingRights = castlingRights_;
+    undo.enPassantSquare = enPassantSquare_;
+    undo.halfmoveClock = halfmoveClock_;
+    undo.capturedPiece = NoPiece;
+    undo.key = key_;
+    undo.pawnKey = pawnKey_;
+
+    if (move.isCapture())
+    {
+        int captureSquare = move.isEnPassant() ? to - Up : to;
+        undo.capturedPiece = board_[captureSquare];
+        removePiece(captureSquare);
+    }
+
+    if (move.isCastle())
+    {
+        bool isKingSide = move.getFlags() == Move::KingCastle;
+        relocatePiece(isKingSide ? to + 1 : to - 2, isKingSide ? to - 1 : to + 1);
+    }
+
+    relocatePiece(from, to);
+
+    if (move.isPromotion())
+    {
+        removePiece(to);
+        putPiece(Us, move.getPromotionType(), to);
+    }
+
+    setCastlingRights(castlingRights_ & ~(castlingRightsLost(from) | castlingRightsLost(to)));
+
+    // the en passant square is only recorded when an enemy pawn can take it, so equal positions hash equally
+    int enPassantSquare = NoSquare;
+    if (move.isDoublePawnPush())
+    {
+        int passedSquare = from + Up;
+        if (Attacks::pawnAttacks<Us>(passedSquare) & getPieces(Them, PieceType::Pawn))
+            enPassantSquare = passedSquare;
+    }
+    setEnPassantSquare(enPassantSquare);
+    setSideToMove(Them);
+
+    halfmoveClock_ = (isPawnMove || move.isCapture()) ? 0 : halfmoveClock_ + 1;
+}
+
+template void Position::makeMove<PieceColor::White>(const Move &move, UndoInfo &undo);
+template void Position::makeMove<PieceColor::Black>(const Move &move, UndoInfo &undo);
+
+// restore the position from before makeMove
+void Position::unmakeMove(const Move &move, const UndoInfo &undo)
+{
+    int from = move.getFrom();
+    int to = move.getTo();
+
+    sideToMove_ = oppositeColor(sideToMove_);
+    castlingRights_ = undo.castlingRights;
+    enPassantSquare_ = undo.enPassantSquare;
+    halfmoveClock_ = undo.halfmoveClock;
+
+    if (move.isPromotion())
+    {
+        removePiece(to);
+        putPiece(sideToMove_, PieceType::Pawn, to);
+    }
+
+    relocatePiece(to, from);
+
+    if (move.isCastle())
+    {
+        bool isKingSide = move.getFlags() == Move::KingCastle;
+        relocatePiece(isKingSide ? to - 1 : to + 1, isKingSide ? to + 1 : to - 2);
+    }
+
+    if (undo.capturedPiece != NoPiece)
+    {
+        putPiece(static_cast<PieceColor>(undo.capturedPiece / 6),
+                 static_cast<PieceType>(undo.capturedPiece % 6), capturedSquare(move));
+    }
+
+    // the piece updates above already restore the piece part, this also covers rights and en passant
+    key_ = undo.key;
+    pawnKey_ = undo.pawnKey;
+}
+
+// pass the turn, only the side to move, the en passant square and the clock change
+void Position::makeNullMove(UndoInfo &undo)
+{
+    undo.castlingRights = castlingRights_;
+    undo.enPassantSquare = enPassantSquare_;
+    undo.halfmoveClock = halfmoveClock_;
+    undo.capturedPiece = NoPiece;
+    undo.key = key_;
+    undo.pawnKey = pawnKey_;
+
+    setEnPassantSquare(NoSquare);
+    setSideToMove(oppositeColor(sideToMove_));
+    ++halfmoveClock_;
+}
+
+void Position::unmakeNullMove(const UndoInfo &undo)
+{
+    sideToMove_ = oppositeColor(sideToMove_);
+    enPassantSquare_ = undo.enPassantSquare;
+    halfmoveClock_ = undo.halfmoveClock;
+    key_ = undo.key;
+}
+
+// the key after a move, built from the same deltas makeMove applies
+template <PieceColor Us>
+Zobrist::Key Position::keyAfter(const Move &move) const
+{
+    constexpr int us = static_cast<int>(Us);
+    constexpr int them = static_cast<int>(oppositeColor(Us));
+    constexpr int Up = Us == PieceColor::White ? 8 : -8;
+    int from = move.getFrom();
+    int to = move.getTo();
+    int type = board_[from] % 6;
+
+    Zobrist::Key key = key_ ^ Zobrist::keys.blackToMove ^ Zobrist::keys.pieces[us][type][from];
+    key ^= Zobrist::keys.pieces[us][move.isPromotion() ? static_cast<int>(move.getPromotionType()) : type][to];
+
+    if (move.isCapture())
+    {
+        int captureSquare = move.isEnPassant() ? to - Up : to;
+        key ^= Zobrist::keys.pieces[them][board_[captureSquare] % 6][captureSquare];
+    }
+
+    if (move.isCastle())
+    {
+        bool isKingSide = move.getFlags() == Move::KingCastle;
+        constexpr int rook = static_cast<int>(PieceType::Rook);
+        key ^= Zobrist::keys.pieces[us][rook][isKingSide ? to + 1 : to - 2] ^
+               Zobrist::keys.pieces[us][rook][isKingSide ? to - 1 : to + 1];
+    }
+
+    int rights = castlingRights_ & ~(castlingRightsLost(from) | castlingRightsLost(to));
+    key ^= Zobrist::keys.castling[castlingRights_] ^ Zobrist::keys.castling[rights];
+
+    if (enPassantSquare_ != NoSquare)
+        key ^= Zobrist::keys.enPassantFile[Bitboards::fileOf(enPassantSquare_)];
+    if (move.isDoublePawnPush() &&
+        (Attacks::pawnAttacks<Us>(from + Up) & getPieces(oppositeColor(Us), PieceType::Pawn)))
+        key ^= Zobrist::keys.enPassantFile[Bitboards::fileOf(from)];
+
+    return key;
+}
+
+template Zobrist::Key Position::keyAfter<PieceColor::White>(const Move &move) const;
+template Zobrist::Key Position::keyAfter<PieceColor::Black>(const Move &move) const;
+
+Zobrist::Key Position::keyAfterNullMove() const
+{
+    Zobrist::Key key = key_ ^ Zobrist::keys.blackToMove;
+    if (enPassantSquare_ != NoSquare)
+        key ^= Zobrist::keys.enPassantFile[Bitboards::fileOf(enPassantSquare_)];
+    return key;
+}
+
+// castling rights that are lost when a piece moves from or to a square
+int Position::castlingRightsLost(int square)
+{
+    switch (square)
+    {
+    case Bitboards::makeSquare(4, 7):
+        return WhiteCastling;
+    case Bitboards::makeSquare(0, 7):
+        return WhiteQueenSide;
+    case Bitboards::makeSquare(7, 7):
+        return WhiteKingSide;
+    case Bitboards::makeSquare(4, 0):
+        return BlackCastling;
+    case Bitboards::makeSquare(0, 0):
+        return BlackQueenSide;
+    case Bitboards::makeSquare(7, 0):
+        return BlackKingSide;
+    default:
+        return NoCastling;
+    }
+}
+
+// pieces of both colors attacking a square, looking outward from the square
+Bitboard Position::getAttackersTo(int square, Bitboard occupied) const
+{
+    Bitboard queens = pieces_[0][static_cast<int>(PieceType::Queen)] | pieces_[1][static_cast<int>(PieceType::Queen)];
+    Bitboard rooks = pieces_[0][static_cast<int>(PieceType::Rook)] | pieces_[1][static_cast<int>(PieceType::Rook)] | queens;
+    Bitboard bishops = pieces_[0][static_cast<int>(PieceType::Bishop)] | pieces_[1][static_cast<int>(PieceType::Bishop)] | queens;
+    Bitboard knights = pieces_[0][static_cast<int>(PieceType::Knight)] | pieces_[1][static_cast<int>(PieceType::Knight)];
+    Bitboard kings = pieces_[0][static_cast<int>(PieceType::King)] | pieces_[1][static_cast<int>(PieceType::King)];
+
+    // a white pawn attacks the square if a black pawn on the square would attack it back
+    return (Attacks::pawnAttacks(PieceColor::Black, square) & getPieces(PieceColor::White, PieceType::Pawn)) |
+           (Attacks::pawnAttacks(PieceColor::White, square) & getPieces(PieceColor::Black, PieceType::Pawn)) |
+           (Attacks::knightAttacks(square) & knights) |
+           (Attacks::kingAttacks(square) & kings) |
+           (Attacks::rookAttacks(square, occupied) & rooks) |
+           (Attacks::bishopAttacks(square, occupied) & bishops);
+}
+
+bool Position::isSquareAttacked(int square, PieceColor byColor) const
+{
+    if (byColor == PieceColor::White)
+        return isAttackedBy<PieceColor::White>(square, getOccupied());
+    return isAttackedBy<PieceColor::Black>(square, getOccupied());
+}
+
+bool Position::isInCheck(PieceColor color) const
+{
+    int kingSquare = getKingSquare(color);
+    if (kingSquare == NoSquare)
+        return false;
+
+    return isSquareAttacked(kingSquare, oppositeColor(color));
+}
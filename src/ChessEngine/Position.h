@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "Attacks.h"
+#include "Bitboard.h"
+#include "Move.h"
+#include "Types.h"
+#include "Zobrist.h"
+
+// castling rights bitmask stored on the position
+enum CastlingRights : int
+{
+    NoCastling = 0,
+    WhiteKingSide = 1,
+    WhiteQueenSide = 2,
+    BlackKingSide = 4,
+    BlackQueenSide = 8,
+    WhiteCastling = WhiteKingSide | WhiteQueenSide,
+    BlackCastling = BlackKingSide | BlackQueenSide,
+    AllCastling = WhiteCastling | BlackCastling
+};
+
+// state needed to take back a move
+struct UndoInfo
+{
+    std::int8_t capturedPiece;
+    int castlingRights;
+    int enPassantSquare;
+    int halfmoveClock;
+    Zobrist::Key key;
+    Zobrist::Key pawnKey;
+};
+
+// bitboard representation of a chess position
+class Position
+{
+public:
+    Position();
+
+    // remove all pieces and reset the state
+    void clear();
+
+    // set up the standard starting position
+    void setStartPosition();
+
+    // set up a position from forsyth-edwards notation, throws std::invalid_argument if it is malformed
+    void setFromFen(const std::string &fen);
+
+    void putPiece(PieceColor color, PieceType type, int square);
+    void removePiece(int square);
+    void relocatePiece(int from, int to);
+
+    // play a move in place, castling, en passant and promotion come from the move flags
+    void makeMove(const Move &move, UndoInfo &undo);
+
+    // the same for a moving color known at compile time, used by the search
+    template <PieceColor Us>
+    void makeMove(const Move &move, UndoInfo &undo);
+
+    // restore the position from before makeMove
+    void unmakeMove(const Move &move, const UndoInfo &undo);
+
+    // pass the turn, only the side to move, the en passant square and the clock change
+    void makeNullMove(UndoInfo &undo);
+    void unmakeNullMove(const UndoInfo &undo);
+
+    // the key after a move or a null move without playing it, lets the search prefetch the hash
+    // entry of a child before making the move
+    template <PieceColor Us>
+    Zobrist::Key keyAfter(const Move &move) const;
+
+    Zobrist::Key keyAfterNullMove() const;
+
+    // castling rights that are lost when a piece moves from or to a square
+    static int castlingRightsLost(int square);
+
+    // square of the piece a move captures, which differs from the end square for en passant
+    static int capturedSquare(const Move &move)
+    {
+        if (!move.isEnPassant())
+            return move.getTo();
+        return Bitboards::makeSquare(move.getEndX(), move.getStartY());
+    }
+
+    // bitboard of one piece type of one color
+    Bitboard getPieces(PieceColor color, PieceType type) const
+    {
+        return pieces_[static_cast<int>(color)][static_cast<int>(type)];
+    }
+
+    // bitboard of all pieces of one color
+    Bitboard getPieces(PieceColor color) const { return occupancy_[static_cast<int>(color)]; }
+
+    Bitboard getOccupied() const { return occupancy_[0] | occupancy_[1]; }
+
+    bool isEmpty(int square) const { return board_[square] == NoPiece; }
+
+    // type and color of the piece on a square, the square must not be empty
+    PieceType getTypeAt(int square) const { return static_cast<PieceType>(board_[square] % 6); }
+    PieceColor getColorAt(int square) const { return static_cast<PieceColor>(board_[square] / 6); }
+
+    PieceColor getSideToMove() const { return sideToMove_; }
+    void setSideToMove(PieceColor color);
+
+    int getCastlingRights() const { return castlingRights_; }
+    void setCastlingRights(int rights);
+
+    int getEnPassantSquare() const { return enPassantSquare_; }
+    void setEnPassantSquare(int square);
+
+    // halfmoves since the last capture or pawn move, for the fifty-move rule
+    int getHalfmoveClock() const { return halfmoveClock_; }
+    void setHalfmoveClock(int halfmoves) { halfmoveClock_ = halfmoves; }
+
+    // zobrist key of the whole position, updated incrementally
+    Zobrist::Key getKey() const { return key_; }
+
+    // zobrist key of the pawns of both colors only
+    Zobrist::Key getPawnKey() const { return pawnKey_; }
+
+    // key of the piece counts of both colors, equal for positions with the same material
+    Zobrist::Key getMaterialKey() const { return materialKey_; }
+
+    // number of pieces of one type of one color, updated incrementally
+    int getPieceCount(PieceColor color, PieceType type) const
+    {
+        return pieceCounts_[static_cast<int>(color)][static_cast<int>(type)];
+    }
+
+    // square of the king of a color, or NoSquare if it is missing
+    int getKingSquare(PieceColor color) const { return kingSquares_[static_cast<int>(color)]; }
+
+    // squares of the pieces of one type of one color, getPieceCount entries in no particular order
+    const std::uint8_t *getPieceSquares(PieceColor color, PieceType type) const
+    {
+        return pieceLists_[static_cast<int>(color)][static_cast<int>(type)];
+    }
+
+    // the most pieces of one type of one color a position can hold
+    static constexpr int MaxPiecesPerType = 16;
+
+    // pieces of both colors attacking a square, looking outward from the square
+    Bitboard getAttackersTo(int square, Bitboard occupied) const;
+    Bitboard getAttackersTo(int square) const { return getAttackersTo(square, getOccupied()); }
+
+    bool isSquareAttacked(int square, PieceColor byColor) const;
+
+    // check whether the pieces of one color attack a square, only that color's attack sets are built
+    template <PieceColor By>
+    bool isAttackedBy(int square, Bitboard occupied) const
+    {
+        constexpr int c = static_cast<int>(By);
+        Bitboard queens = pieces_[c][static_cast<int>(PieceType::Queen)];
+
+        return (Attacks::pawnAttacks<oppositeColor(By)>(square) & pieces_[c][static_cast<int>(PieceType::Pawn)]) ||
+               (Attacks::knightAttacks(square) & pieces_[c][static_cast<int>(PieceType::Knight)]) ||
+               (Attacks::kingAttacks(square) & pieces_[c][static_cast<int>(PieceType::King)]) ||
+               (Attacks::bishopAttacks(square, occupied) & (pieces_[c][static_cast<int>(PieceType::Bishop)] | queens)) ||
+               (Attacks::rookAttacks(square, occupied) & (pieces_[c][static_cast<int>(PieceType::Rook)] | queens));
+    }
+
+    bool isInCheck(PieceColor color) const;
+
+private:
+    static constexpr std::int8_t NoPiece = -1;
+
+    Bitboard pieces_[2][6];
+    Bitboard occupancy_[2];
+    std::int8_t board_[64];
+    std::uint8_t pieceCounts_[2][6];
+
+    // dense square lists per piece type, and for every occupied square its index in its list
+    std::uint8_t pieceLists_[2][6][MaxPiecesPerType];
+    std::uint8_t pieceIndex_[64];
+    std::int8_t kingSquares_[2];
+
+    PieceColor sideToMove_;
+    int castlingRights_;
+    int enPassantSquare_;
+    int halfmoveClock_;
+
+    Zobrist::Key key_;
+    Zobrist::Key pawnKey_;
+    Zobrist::Key materialKey_;
+};
+
+extern template void Position::makeMove<PieceColor::White>(const Move &move, UndoInfo &undo);
+extern template void Position::makeMove<PieceColor::Black>(const Move &move, UndoInfo &undo);
+extern template Zobrist::Key Position::keyAfter<PieceColor::White>(const Move &move) const;
+extern template Zobrist::Key Position::keyAfter<PieceColor::Black>(const Move &move) const;
@@ -0,0 +1,119 @@
+#include "TranspositionTable.h"
+#include <climits>
+
+namespace
+{
+    Move moveOf(std::uint64_t data)
+    {
+        return Move(data & 0x3F, (data >> 6) & 0x3F, (data >> 12) & 0xF);
+    }
+
+    int scoreOf(std::uint64_t data) { return static_cast<std::int32_t>(static_cast<std::uint32_t>(data >> 16)); }
+    int depthOf(std::uint64_t data) { return static_cast<std::int8_t>(static_cast<std::uint8_t>(data >> 48)); }
+    Bound boundOf(std::uint64_t data) { return static_cast<Bound>((data >> 56) & 3); }
+    unsigned ageOf(std::uint64_t data) { return static_cast<unsigned>(data >> 58); }
+}
+
+// constructor
+TranspositionTable::TranspositionTable(std::size_t megabytes)
+    : mask_(0), age_(0)
+{
+    resize(megabytes);
+}
+
+// reallocate to the largest power of two number of buckets that fits, clears the table
+void TranspositionTable::resize(std::size_t megabytes)
+{
+    std::size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024)
+        count *= 2;
+
+    buckets_ = std::make_unique<Bucket[]>(count);
+    mask_ = count - 1;
+    age_ = 0;
+}
+
+void TranspositionTable::clear()
+{
+    for (std::size_t i = 0; i <= mask_; ++i)
+    {
+        for (Entry &entry : buckets_[i].entries)
+        {
+            entry.check.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    age_ = 0;
+}
+
+// look up a position, returns false if it is not stored
+bool TranspositionTable::probe(Zobrist::Key key, TTData &data) const
+{
+    const Bucket &bucket = buckets_[key & mask_];
+
+    for (const Entry &entry : bucket.entries)
+    {
+        std::uint64_t entryData = entry.data.load(std::memory_order_relaxed);
+        std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+
+        if ((check ^ entryData) != key || boundOf(entryData) == Bound::None)
+            continue;
+
+        data.move = moveOf(entryData);
+        data.score = scoreOf(entryData);
+        data.depth = depthOf(entryData);
+        data.bound = boundOf(entryData);
+        return true;
+    }
+
+    return false;
+}
+
+// keeps the stored move when the new result has none
+void TranspositionTable::store(Zobrist::Key key, Move move, int score, int depth, Bound bound)
+{
+    Bucket &bucket = buckets_[key & mask_];
+    Entry *replace = &bucket.entries[0];
+    int replaceValue = INT_MAX;
+
+    for (Entry &entry : bucket.entries)
+    {
+        std::uint64_t entryData = entry.data.load(std::memory_order_relaxed);
+        std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+
+        if ((check ^ entryData) == key && boundOf(entryData) != Bound::None)
+        {
+            // a shallower inexact result of the same search does not overwrite a deeper one
+            if (bound != Bound::Exact && depth + 2 < depthOf(entryData) && ageOf(entryData) == age_)
+                return;
+
+            if (move.isNull())
+                move = moveOf(entryData);
+
+            replace = &entry;
+            break;
+        }
+
+        // empty entries go first, then entries from older searches, then the shallowest
+        int relativeAge = static_cast<int>((age_ - ageOf(entryData)) & AgeMask);
+        int value = boundOf(entryData) == Bound::None ? INT_MIN : depthOf(entryData) - 4 * relativeAge;
+        if (value < replaceValue)
+        {
+            replaceValue = value;
+            replace = &entry;
+        }
+    }
+
+    std::uint64_t data = pack(move, score, depth, bound, age_);
+    replace->check.store(key ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
+
+std::uint64_t TranspositionTable::pack(Move move, int score, int depth, Bound bound, unsigned age)
+{
+    return static_cast<std::uint64_t>(move.getData()) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(score)) << 16 |
+           static_cast<std::uint64_t>(static_cast<std::uint8_t>(depth)) << 48 |
+           static_cast<std::uint64_t>(bound) << 56 |
+           static_cast<std::uint64_t>(age) << 58;
+}
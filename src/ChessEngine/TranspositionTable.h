@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Move.h"
+#include "Zobrist.h"
+
+// what a stored score says about the true value of the position
+enum class Bound : std::uint8_t
+{
+    None,
+    Upper,
+    Lower,
+    Exact
+};
+
+// one probed entry, unpacked
+struct TTData
+{
+    Move move;
+    int score;
+    int depth;
+    Bound bound;
+};
+
+// search results keyed by zobrist key, shared between searches and safe to use from several threads
+// without locks: each entry stores key ^ data next to data, so a torn write fails the key check
+class TranspositionTable
+{
+public:
+    explicit TranspositionTable(std::size_t megabytes);
+
+    // reallocate to the largest power of two number of buckets that fits, clears the table
+    void resize(std::size_t megabytes);
+
+    void clear();
+
+    // start a new search, entries from earlier searches are replaced first
+    void newSearch() { age_ = (age_ + 1) & AgeMask; }
+
+    // look up a position, returns false if it is not stored
+    bool probe(Zobrist::Key key, TTData &data) const;
+
+    // keeps the stored move when the new result has none
+    void store(Zobrist::Key key, Move move, int score, int depth, Bound bound);
+
+    // load the bucket of a key into the cache ahead of the probe
+    void prefetch(Zobrist::Key key) const
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(&buckets_[key & mask_]);
+#endif
+    }
+
+private:
+    static constexpr int EntriesPerBucket = 4;
+    static constexpr unsigned AgeMask = 63;
+
+    // data packs the move in bits 0-15, the score in 16-47, the depth in 48-55, the bound in 56-57
+    // and the age in 58-63
+    struct Entry
+    {
+        std::atomic<std::uint64_t> check{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+
+    // one cache line
+    struct alignas(64) Bucket
+    {
+        Entry entries[EntriesPerBucket];
+    };
+
+    static_assert(sizeof(Bucket) == 64, "a bucket must fill exactly one cache line");
+
+    static std::uint64_t pack(Move move, int score, int depth, Bound bound, unsigned age);
+
+    std::unique_ptr<Bucket[]> buckets_;
+    std::size_t mask_;
+    unsigned age_;
+};
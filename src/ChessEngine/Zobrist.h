@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+// random keys for zobrist hashing, generated at compile time so every build hashes the same way
+namespace Zobrist
+{
+    using Key = std::uint64_t;
+
+    struct Keys
+    {
+        Key pieces[2][6][64];
+        Key castling[16];
+        Key enPassantFile[8];
+        Key blackToMove;
+    };
+
+    // splitmix64 step, advances the state and returns the next key
+    constexpr Key nextKey(Key &state)
+    {
+        Key z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    constexpr Keys generateKeys()
+    {
+        Keys keys{};
+        Key state = 0x2545F4914F6CDD1DULL;
+
+        for (auto &colorKeys : keys.pieces)
+            for (auto &typeKeys : colorKeys)
+                for (auto &key : typeKeys)
+                    key = nextKey(state);
+
+        // each castling right gets its own key, a rights mask hashes to the xor of its rights
+        Key rightKeys[4] = {};
+        for (auto &key : rightKeys)
+            key = nextKey(state);
+
+        for (int rights = 0; rights < 16; ++rights)
+        {
+            keys.castling[rights] = 0;
+            for (int right = 0; right < 4; ++right)
+            {
+                if (rights & (1 << right))
+                    keys.castling[rights] ^= rightKeys[right];
+            }
+        }
+
+        for (auto &key : keys.enPassantFile)
+            key = nextKey(state);
+
+        keys.blackToMove = nextKey(state);
+
+        return keys;
+    }
+
+    inline constexpr Keys keys = generateKeys();
+}
@@ -1,12 +1,6 @@
 #include "Game.h"
 #include "Board.h"
 #include "UIManager.h"
-#include "pieces/King.h"
-#include "pieces/Queen.h"
-#include "pieces/Bishop.h"
-#include "pieces/Knight.h"
-#include "pieces/Rook.h"
-#include "pieces/Pawn.h"
 #include <iostream>
 #include <algorithm>
 
@@ -14,13 +8,14 @@
 Game::Game()
     : window(sf::VideoMode(800, 800), "Chess Game"),
       board(),
+      boardRenderer(),
       uiManager(),
       gameState(GameState::Playing),
       currentTurn(PieceColor::White),
-      selectedPiece(nullptr),
-      lastMove({nullptr, {-1, -1}}),
+      selectedSquare(NoSquare),
       aiPlayer_(PieceColor::Black)
 {
+    gameStatus = board.computeGameStatus();
 }
 
 // run the game loop
@@ -41,43 +36,58 @@ void Game::update()
     {
         Move bestMove = aiFutureMove.get();
 
-        Piece *pieceToMove = board.getPieceAt(bestMove.startX, bestMove.startY);
-        if (!pieceToMove)
+        if (!board.hasPieceAt(bestMove.getStartX(), bestMove.getStartY(), PieceColor::Black))
         {
             std::cerr << "failed to find the piece to move at the expected position." << std::endl;
             aiMoveInProgress = false;
             return;
         }
 
-        bool isCastling = false;
-        if (pieceToMove->getType() == PieceType::King && std::abs(bestMove.endX - bestMove.startX) == 2)
+        if (bestMove.isCastle())
         {
-            isCastling = true;
             std::cout << "ai is attempting to castle.\n";
         }
 
-        board.movePiece(pieceToMove, bestMove.endX, bestMove.endY, false, isCastling);
+        board.makeMove(bestMove);
 
-        lastMove = {pieceToMove, {bestMove.endX, bestMove.endY}};
         aiMoveInProgress = false;
 
-        if (board.isKingInCheck(PieceColor::White) && !board.hasValidMoves(PieceColor::White))
-        {
-            uiManager.displayGameOver("checkmate! ai wins!");
-            gameState = GameState::GameOver;
-        }
-        else if (!board.hasValidMoves(PieceColor::White))
-        {
-            uiManager.displayGameOver("stalemate! it's a draw!");
-            gameState = GameState::GameOver;
-        }
-        else
+        if (!updateGameStatus())
         {
             currentTurn = PieceColor::White;
         }
     }
 }
 
+// compute the legal moves and result of the new position once, and show the result if the game is over
+bool Game::updateGameStatus()
+{
+    gameStatus = board.computeGameStatus();
+
+    switch (gameStatus.result)
+    {
+    case GameResult::Ongoing:
+        return false;
+    case GameResult::Checkmate:
+        // the side to move is mated, the ai plays black
+        uiManager.displayGameOver(board.getPosition().getSideToMove() == PieceColor::White ? "checkmate!\nai wins!"
+                                                                                            : "checkmate!\nwhite wins!");
+        break;
+    case GameResult::Stalemate:
+        uiManager.displayGameOver("stalemate!\nit's a draw!");
+        break;
+    case GameResult::InsufficientMaterial:
+        uiManager.displayGameOver("draw!\ninsufficient material.");
+        break;
+    case GameResult::FiftyMoveDraw:
+        uiManager.displayGameOver("draw!\nfifty-move rule.");
+        break;
+    }
+
+    gameState = GameState::GameOver;
+    return true;
+}
+
 // process user and system events
 void Game::processEvents()
 {
@@ -106,7 +116,7 @@ void Game::processEvents()
                 {
                     aiMoveInProgress = true;
                     aiFutureMove = std::async(std::launch::async, [this]()
-                                              { return aiPlayer_.getBestMove(board, lastMove); });
+                                              { return aiPlayer_.getBestMove(board, gameStatus.legalMoves); });
                 }
             }
         }
@@ -121,74 +131,39 @@ void Game::handleClick(sf::Vector2i mousePos)
         int boardX = mousePos.x / 100;
         int boardY = mousePos.y / 100;
 
-        if (selectedPiece == nullptr)
+        if (selectedSquare == NoSquare)
         {
-            Piece *piece = board.getPieceAt(boardX, boardY);
-            if (piece && piece->getColor() == currentTurn)
+            if (board.hasPieceAt(boardX, boardY, currentTurn))
             {
-                selectedPiece = piece;
-                validMoves = board.getValidMoves(piece, lastMove);
+                // the moves of the selected piece come from the legal moves computed after the last move
+                selectedSquare = Bitboards::makeSquare(boardX, boardY);
+                validMoves.clear();
+                for (const auto &move : gameStatus.legalMoves)
+                {
+                    if (move.getFrom() == selectedSquare)
+                        validMoves.push_back(move);
+                }
             }
         }
         else
         {
-            if (std::find(validMoves.begin(), validMoves.end(), std::make_pair(boardX, boardY)) != validMoves.end())
-            {
-                bool enPassant = false;
-                bool castling = false;
-
-                if (Pawn *pawn = dynamic_cast<Pawn *>(selectedPiece))
-                {
-                    int direction = (pawn->getColor() == PieceColor::White) ? -1 : 1;
-                    if (boardY == pawn->getY() + direction && std::abs(boardX - pawn->getX()) == 1)
-                    {
-                        Piece *target = board.getPieceAt(boardX, boardY);
-                        if (!target)
-                        {
-                            enPassant = true;
-                        }
-                    }
-                }
-
-                if (King *king = dynamic_cast<King *>(selectedPiece))
-                {
-                    int dx = boardX - king->getX();
-                    if (std::abs(dx) == 2)
-                    {
-                        castling = true;
-                    }
-                }
+            // there is no promotion dialog, a pawn reaching the last rank becomes a queen
+            auto chosenMove = std::find_if(validMoves.begin(), validMoves.end(), [&](const Move &move)
+                                           { return move.getEndX() == boardX && move.getEndY() == boardY &&
+                                                    (!move.isPromotion() || move.getPromotionType() == PieceType::Queen); });
 
+            if (chosenMove != validMoves.end())
+            {
                 try
                 {
-                    board.movePiece(selectedPiece, boardX, boardY, enPassant, castling);
+                    board.makeMove(*chosenMove);
 
-                    lastMove = {selectedPiece, {boardX, boardY}};
-
-                    selectedPiece = nullptr;
+                    selectedSquare = NoSquare;
                     validMoves.clear();
 
-                    PieceColor opponentColor = (currentTurn == PieceColor::White) ? PieceColor::Black : PieceColor::White;
-
-                    if (board.isInsufficientMaterial())
+                    if (!updateGameStatus())
                     {
-                        uiManager.displayGameOver("draw!\ninsufficient material.");
-                        gameState = GameState::GameOver;
-                    }
-                    else if (board.isKingInCheck(opponentColor) && !board.hasValidMoves(opponentColor))
-                    {
-                        std::string winner = (currentTurn == PieceColor::White) ? "white" : "black";
-                        uiManager.displayGameOver("checkmate!\n" + winner + " wins!");
-                        gameState = GameState::GameOver;
-                    }
-                    else if (!board.hasValidMoves(opponentColor))
-                    {
-                        uiManager.displayGameOver("stalemate!\nit's a draw!");
-                        gameState = GameState::GameOver;
-                    }
-                    else
-                    {
-                        currentTurn = opponentColor;
+                        currentTurn = oppositeColor(currentTurn);
                     }
                 }
                 catch (const std::exception &e)
@@ -199,7 +174,7 @@ void Game::handleClick(sf::Vector2i mousePos)
             else
             {
                 std::cout << "invalid move attempted." << std::endl;
-                selectedPiece = nullptr;
+                selectedSquare = NoSquare;
                 validMoves.clear();
             }
         }
@@ -210,7 +185,7 @@ void Game::handleClick(sf::Vector2i mousePos)
 void Game::render()
 {
     window.clear(sf::Color::White);
-    board.draw(window, selectedPiece, validMoves);
+    boardRenderer.draw(window, board, validMoves);
     uiManager.draw(window, gameState);
     window.display();
 }
@@ -220,10 +195,10 @@ void Game::replayGame()
 {
     std::cout << "replaying the game..." << std::endl;
     board.initializeBoard();
+    gameStatus = board.computeGameStatus();
     currentTurn = PieceColor::White;
-    selectedPiece = nullptr;
+    selectedSquare = NoSquare;
     validMoves.clear();
-    lastMove = {nullptr, {-1, -1}};
     gameState = GameState::Playing;
     std::cout << "game has been reset." << std::endl;
 }
@@ -236,13 +211,13 @@ void Game::exitGame()
 }
 
 // convert move to chess notation
-void Game::toChessNotation(Piece *selectedPiece, int boardX, int boardY)
+void Game::toChessNotation(PieceType pieceType, int boardX, int boardY)
 {
     char type = '\0';
     int rank = boardY + 1;
     char file = 'a' + boardX;
 
-    switch (selectedPiece->getType())
+    switch (pieceType)
     {
     case PieceType::Pawn:
         break;
@@ -279,24 +254,16 @@ void Game::toChessNotation(Piece *selectedPiece, int boardX, int boardY)
 // handle AI move
 void Game::handleAIMove()
 {
-    auto bestMove = aiPlayer_.getBestMove(board, lastMove);
+    auto bestMove = aiPlayer_.getBestMove(board, gameStatus.legalMoves);
 
-    Piece *pieceToMove = board.getPieceAt(bestMove.startX, bestMove.startY);
-    if (!pieceToMove)
+    if (!board.hasPieceAt(bestMove.getStartX(), bestMove.getStartY(), currentTurn))
     {
         std::cerr << "failed to find the piece to move at the expected position." << std::endl;
         return;
     }
 
-    bool isCastling = false;
-    if (pieceToMove->getType() == PieceType::King && std::abs(bestMove.endX - bestMove.startX) == 2)
-    {
-        isCastling = true;
-    }
-
-    board.movePiece(pieceToMove, bestMove.endX, bestMove.endY, false, isCastling);
-
-    lastMove = {pieceToMove, {bestMove.endX, bestMove.endY}};
+    board.makeMove(bestMove);
+    gameStatus = board.computeGameStatus();
 
     currentTurn = (currentTurn == PieceColor::White) ? PieceColor::Black : PieceColor::White;
 }
@@ -4,8 +4,8 @@
 #include <vector>
 #include <memory>
 #include "Board.h"
+#include "BoardRenderer.h"
 #include "UIManager.h"
-#include "pieces/Piece.h"
 #include "ChessEngine/AIPlayer.h"
 #include <thread>
 #include <future>
@@ -23,12 +23,15 @@ private:
     void replayGame();
     void exitGame();
 
-    void toChessNotation(Piece *selectedPiece, int boardX, int boardY);
+    void toChessNotation(PieceType pieceType, int boardX, int boardY);
 
     void handleAIMove();
 
     void update();
 
+    // refresh gameStatus after a move, returns true and shows the result if the game has ended
+    bool updateGameStatus();
+
     std::future<Move> aiFutureMove;
     bool aiMoveInProgress = false;
 
@@ -36,11 +39,14 @@ private:
 
     sf::RenderWindow window;
     Board board;
+    BoardRenderer boardRenderer;
     UIManager uiManager;
     GameState gameState;
 
     PieceColor currentTurn;
-    Piece *selectedPiece;
-    std::vector<std::pair<int, int>> validMoves;
-    std::pair<Piece *, std::pair<int, int>> lastMove;
+    int selectedSquare;
+    MoveList validMoves;
+
+    // legal moves and result of the current position, shared by clicks, game-over checks and the ai
+    GameStatus gameStatus;
 };
@@ -13,4 +13,9 @@ enum class PieceType
     Bishop,
     Knight,
     Pawn
-};
\ No newline at end of file
+};
+
+constexpr PieceColor oppositeColor(PieceColor color)
+{
+    return color == PieceColor::White ? PieceColor::Black : PieceColor::White;
+}
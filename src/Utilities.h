@@ -1,17 +1,8 @@
 
 #pragma once
-#include <vector>
 #include "Types.h"
 #include <string>
 
-class Piece;
-
-bool isOccupied(int x, int y, const std::vector<Piece *> &pieces);
-bool isOccupiedByOpponent(int x, int y, PieceColor color, const std::vector<Piece *> &pieces);
-bool isSquareUnderAttack(int x, int y, PieceColor color, const std::vector<Piece *> &pieces);
-
-bool isPathClear(int startX, int startY, int endX, int endY, const std::vector<Piece *> &pieces);
-
 inline std::string pieceTypeToString(PieceType type)
 {
     switch (type)
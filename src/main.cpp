@@ -1,11 +1,36 @@
 #include "Game.h"
+#include "ChessEngine/Attacks.h"
 #include <iostream>
+#include <string>
 
-int main()
+namespace
+{
+    // read --slider-backend=<auto|magic|pext> (or --slider-backend <value>) from the command line
+    Attacks::SliderBackend readSliderBackend(int argc, char *argv[])
+    {
+        const std::string option = "--slider-backend";
+        std::string value = "auto";
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == option && i + 1 < argc)
+                value = argv[++i];
+            else if (arg.rfind(option + "=", 0) == 0)
+                value = arg.substr(option.size() + 1);
+        }
+
+        return Attacks::parseSliderBackend(value);
+    }
+}
+
+int main(int argc, char *argv[])
 {
     try
     {
         std::cout << "Starting the game..." << std::endl;
+        Attacks::init(readSliderBackend(argc, argv));
+        std::cout << "Slider backend: " << Attacks::sliderBackendName(Attacks::getSliderBackend()) << std::endl;
         Game game;
         game.run();
         std::cout << "Game exited normally." << std::endl;
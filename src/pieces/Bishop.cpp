@@ -1,40 +1,8 @@
-
 #include "Bishop.h"
-#include "../Board.h"
+#include "ChessEngine/Attacks.h"
+#include "ChessEngine/Position.h"
 
-std::vector<std::pair<int, int>> Bishop::getPotentialMoves(const Board &board) const
+Bitboard Bishop::getTargets(const Position &position, int square, PieceColor color)
 {
-    std::vector<std::pair<int, int>> moves;
-
-    int directions[4][2] = {
-        {1, -1}, {1, 1}, {-1, 1}, {-1, -1}};
-
-    for (auto &dir : directions)
-    {
-        int newX = x_ + dir[0];
-        int newY = y_ + dir[1];
-
-        while (newX >= 0 && newX <= 7 && newY >= 0 && newY <= 7)
-        {
-            Piece *target = board.getPieceAt(newX, newY);
-            if (target)
-            {
-                if (target->getColor() != color_)
-                {
-                    moves.emplace_back(newX, newY);
-                }
-                break;
-            }
-            moves.emplace_back(newX, newY);
-            newX += dir[0];
-            newY += dir[1];
-        }
-    }
-
-    return moves;
+    return Attacks::bishopAttacks(square, position.getOccupied()) & ~position.getPieces(color);
 }
-
-std::unique_ptr<Piece> Bishop::clone() const
-{
-    return std::make_unique<Bishop>(*this);
-}
\ No newline at end of file
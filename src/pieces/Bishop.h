@@ -1,18 +1,14 @@
-
 #pragma once
-#include "Piece.h"
 
-class Bishop : public Piece
-{
-public:
-    Bishop(int x, int y, const sf::Sprite &sprite, PieceColor color)
-        : Piece(x, y, sprite, color)
-    {
-        type_ = PieceType::Bishop;
-        isSliding_ = true;
-    }
+#include "../Types.h"
+#include "ChessEngine/Bitboard.h"
 
-    virtual std::vector<std::pair<int, int>> getPotentialMoves(const Board &board) const override;
+class Position;
 
-    virtual std::unique_ptr<Piece> clone() const override;
+// movement of a bishop, used by the move generator
+class Bishop
+{
+public:
+    // get the squares a bishop of a color can reach from a square
+    static Bitboard getTargets(const Position &position, int square, PieceColor color);
 };
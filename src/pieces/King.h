@@ -1,23 +1,14 @@
-
 #pragma once
 
-#include "Piece.h"
+#include "../Types.h"
+#include "ChessEngine/Bitboard.h"
+
+class Position;
 
-class King : public Piece
+// movement of a king, used by the move generator
+class King
 {
 public:
-    King(int x, int y, const sf::Sprite &sprite, PieceColor color)
-        : Piece(x, y, sprite, color)
-    {
-        type_ = PieceType::King;
-        isSliding_ = false;
-    }
-
-    King(const King &other) : Piece(other)
-    {
-    }
-
-    virtual std::vector<std::pair<int, int>> getPotentialMoves(const Board &board) const override;
-
-    virtual std::unique_ptr<Piece> clone() const override;
-};
\ No newline at end of file
+    // get the squares a king of a color can reach from a square
+    static Bitboard getTargets(const Position &position, int square, PieceColor color);
+};
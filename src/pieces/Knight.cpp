@@ -1,33 +1,8 @@
-
 #include "Knight.h"
-#include "../Board.h"
+#include "ChessEngine/Attacks.h"
+#include "ChessEngine/Position.h"
 
-std::vector<std::pair<int, int>> Knight::getPotentialMoves(const Board &board) const
+Bitboard Knight::getTargets(const Position &position, int square, PieceColor color)
 {
-    std::vector<std::pair<int, int>> moves;
-
-    int deltas[8][2] = {
-        {1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
-
-    for (auto &delta : deltas)
-    {
-        int newX = x_ + delta[0];
-        int newY = y_ + delta[1];
-
-        if (newX < 0 || newX > 7 || newY < 0 || newY > 7)
-            continue;
-
-        Piece *target = board.getPieceAt(newX, newY);
-        if (target && target->getColor() == color_)
-            continue;
-
-        moves.emplace_back(newX, newY);
-    }
-
-    return moves;
+    return Attacks::knightAttacks(square) & ~position.getPieces(color);
 }
-
-std::unique_ptr<Piece> Knight::clone() const
-{
-    return std::make_unique<Knight>(*this);
-}
\ No newline at end of file
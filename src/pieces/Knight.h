@@ -1,18 +1,14 @@
-
 #pragma once
-#include "Piece.h"
 
-class Knight : public Piece
-{
-public:
-    Knight(int x, int y, const sf::Sprite &sprite, PieceColor color)
-        : Piece(x, y, sprite, color)
-    {
-        type_ = PieceType::Knight;
-        isSliding_ = false;
-    }
+#include "../Types.h"
+#include "ChessEngine/Bitboard.h"
 
-    virtual std::vector<std::pair<int, int>> getPotentialMoves(const Board &board) const override;
+class Position;
 
-    virtual std::unique_ptr<Piece> clone() const override;
+// movement of a knight, used by the move generator
+class Knight
+{
+public:
+    // get the squares a knight of a color can reach from a square
+    static Bitboard getTargets(const Position &position, int square, PieceColor color);
 };
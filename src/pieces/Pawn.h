@@ -1,18 +1,25 @@
 
 #pragma once
-#include "Piece.h"
 
-class Pawn : public Piece
+#include "../Types.h"
+#include "ChessEngine/Attacks.h"
+#include "ChessEngine/Position.h"
+
+// movement of a pawn, used by the move generator
+class Pawn
 {
 public:
-    Pawn(int x, int y, const sf::Sprite &sprite, PieceColor color)
-        : Piece(x, y, sprite, color)
+    // get the squares a pawn of a color can reach from a square, the color is fixed at compile time
+    // so the push direction and double push rank are constants
+    template <PieceColor C>
+    static Bitboard getTargets(const Position &position, int square)
     {
-        type_ = PieceType::Pawn;
-        isSliding_ = false;
-    }
+        constexpr Bitboard DoublePushRank = C == PieceColor::White ? Bitboards::Rank3 : Bitboards::Rank6;
+        Bitboard empty = ~position.getOccupied();
 
-    virtual std::vector<std::pair<int, int>> getPotentialMoves(const Board &board) const override;
+        Bitboard pushes = Attacks::pawnPushes<C>(Bitboards::squareBB(square)) & empty;
+        pushes |= Attacks::pawnPushes<C>(pushes & DoublePushRank) & empty;
 
-    virtual std::unique_ptr<Piece> clone() const override;
+        return pushes | (Attacks::pawnAttacks<C>(square) & position.getPieces(oppositeColor(C)));
+    }
 };
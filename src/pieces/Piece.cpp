@@ -1 +0,0 @@
-#include "Piece.h"
\ No newline at end of file
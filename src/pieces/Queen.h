@@ -1,18 +1,14 @@
-
 #pragma once
-#include "Piece.h"
 
-class Queen : public Piece
-{
-public:
-    Queen(int x, int y, const sf::Sprite &sprite, PieceColor color)
-        : Piece(x, y, sprite, color)
-    {
-        type_ = PieceType::Queen;
-        isSliding_ = true;
-    }
+#include "../Types.h"
+#include "ChessEngine/Bitboard.h"
 
-    virtual std::vector<std::pair<int, int>> getPotentialMoves(const Board &board) const override;
+class Position;
 
-    virtual std::unique_ptr<Piece> clone() const override;
+// movement of a queen, used by the move generator
+class Queen
+{
+public:
+    // get the squares a queen of a color can reach from a square
+    static Bitboard getTargets(const Position &position, int square, PieceColor color);
 };
@@ -1,40 +1,8 @@
-
 #include "Rook.h"
-#include "../Board.h"
-
-std::vector<std::pair<int, int>> Rook::getPotentialMoves(const Board &board) const
-{
-    std::vector<std::pair<int, int>> moves;
-
-    int directions[4][2] = {
-        {0, -1}, {1, 0}, {0, 1}, {-1, 0}};
-
-    for (auto &dir : directions)
-    {
-        int newX = x_ + dir[0];
-        int newY = y_ + dir[1];
-
-        while (newX >= 0 && newX <= 7 && newY >= 0 && newY <= 7)
-        {
-            Piece *target = board.getPieceAt(newX, newY);
-            if (target)
-            {
-                if (target->getColor() != color_)
-                {
-                    moves.emplace_back(newX, newY);
-                }
-                break;
-            }
-            moves.emplace_back(newX, newY);
-            newX += dir[0];
-            newY += dir[1];
-        }
-    }
-
-    return moves;
-}
+#include "ChessEngine/Attacks.h"
+#include "ChessEngine/Position.h"
 
-std::unique_ptr<Piece> Rook::clone() const
+Bitboard Rook::getTargets(const Position &position, int square, PieceColor color)
 {
-    return std::make_unique<Rook>(*this);
+    return Attacks::rookAttacks(square, position.getOccupied()) & ~position.getPieces(color);
 }
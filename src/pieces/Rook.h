@@ -1,22 +1,14 @@
-
 #pragma once
-#include "Piece.h"
-
-class Rook : public Piece
-{
-public:
-    Rook(int x, int y, const sf::Sprite &sprite, PieceColor color)
-        : Piece(x, y, sprite, color)
-    {
-        type_ = PieceType::Rook;
-        isSliding_ = true;
-    }
 
-    virtual std::vector<std::pair<int, int>> getPotentialMoves(const Board &board) const override;
+#include "../Types.h"
+#include "ChessEngine/Bitboard.h"
 
-    virtual std::unique_ptr<Piece> clone() const override;
+class Position;
 
-    Rook(const Rook &other) : Piece(other)
-    {
-    }
+// movement of a rook, used by the move generator
+class Rook
+{
+public:
+    // get the squares a rook of a color can reach from a square
+    static Bitboard getTargets(const Position &position, int square, PieceColor color);
 };
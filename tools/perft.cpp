@@ -0,0 +1,258 @@
+#include "ChessEngine/Attacks.h"
+#include "ChessEngine/MoveGen.h"
+#include "ChessEngine/Position.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// counts leaf nodes of the legal move tree, used to check and benchmark move generation
+namespace
+{
+    const std::string StartFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    struct Options
+    {
+        std::string fen = StartFen;
+        int depth = 5;
+        bool divide = false;
+        unsigned threads = std::thread::hardware_concurrency();
+        std::size_t hashMegabytes = 0;
+        Attacks::SliderBackend sliderBackend = Attacks::SliderBackend::Auto;
+    };
+
+    // subtree counts shared by all threads, an entry is only trusted if its check word matches
+    class PerftTable
+    {
+    public:
+        explicit PerftTable(std::size_t megabytes)
+        {
+            std::size_t count = 1;
+            while (count * 2 * sizeof(Entry) <= megabytes * 1024 * 1024)
+                count *= 2;
+
+            entries_ = std::make_unique<Entry[]>(count);
+            mask_ = count - 1;
+        }
+
+        bool probe(Zobrist::Key key, int depth, std::uint64_t &nodes) const
+        {
+            const Entry &entry = entries_[key & mask_];
+            std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+            std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+
+            // a torn write from another thread fails the check instead of returning a wrong count
+            if ((check ^ data) != key || static_cast<int>(data & 0xFF) != depth)
+                return false;
+
+            nodes = data >> 8;
+            return true;
+        }
+
+        void store(Zobrist::Key key, int depth, std::uint64_t nodes)
+        {
+            Entry &entry = entries_[key & mask_];
+            std::uint64_t data = (nodes << 8) | static_cast<std::uint64_t>(depth);
+
+            entry.check.store(key ^ data, std::memory_order_relaxed);
+            entry.data.store(data, std::memory_order_relaxed);
+        }
+
+    private:
+        struct Entry
+        {
+            std::atomic<std::uint64_t> check{0};
+            std::atomic<std::uint64_t> data{0};
+        };
+
+        std::unique_ptr<Entry[]> entries_;
+        std::size_t mask_;
+    };
+
+    // the depth goes into the key so one position at different depths gets different slots
+    Zobrist::Key depthKey(const Position &position, int depth)
+    {
+        return position.getKey() ^ (Zobrist::Key(depth) * 0x9E3779B97F4A7C15ULL);
+    }
+
+    std::uint64_t perft(Position &position, int depth, PerftTable *table)
+    {
+        if (depth == 0)
+            return 1;
+
+        MoveList moves;
+        MoveGen::generateLegalMoves(position, position.getSideToMove(), moves);
+
+        // bulk counting, the last ply only needs the number of legal moves
+        if (depth == 1)
+            return moves.size();
+
+        std::uint64_t nodes = 0;
+        Zobrist::Key key = 0;
+        if (table)
+        {
+            key = depthKey(position, depth);
+            if (table->probe(key, depth, nodes))
+                return nodes;
+        }
+
+        for (const auto &move : moves)
+        {
+            UndoInfo undo;
+            position.makeMove(move, undo);
+            nodes += perft(position, depth - 1, table);
+            position.unmakeMove(move, undo);
+        }
+
+        if (table)
+            table->store(key, depth, nodes);
+
+        return nodes;
+    }
+
+    // long algebraic notation, e.g. e2e4 or e7e8q
+    std::string toUci(const Move &move)
+    {
+        std::string text;
+        for (int square : {move.getFrom(), move.getTo()})
+        {
+            text += static_cast<char>('a' + Bitboards::fileOf(square));
+            text += static_cast<char>('1' + Bitboards::rankOf(square));
+        }
+
+        if (move.isPromotion())
+            text += "nbrq"[move.getFlags() & 3];
+
+        return text;
+    }
+
+    void printUsage()
+    {
+        std::cout << "usage: perft [--depth N] [--fen \"<fen>\"] [--divide] [--threads N] [--hash MB]\n"
+                  << "             [--slider-backend auto|magic|pext]" << std::endl;
+    }
+
+    // accepts both --option value and --option=value
+    Options parseOptions(int argc, char *argv[])
+    {
+        Options options;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            std::string value;
+
+            std::size_t equals = arg.find('=');
+            if (equals != std::string::npos)
+            {
+                value = arg.substr(equals + 1);
+                arg = arg.substr(0, equals);
+            }
+
+            auto nextValue = [&]()
+            {
+                if (!value.empty())
+                    return value;
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("Missing value for " + arg);
+                return std::string(argv[++i]);
+            };
+
+            if (arg == "--depth")
+                options.depth = std::stoi(nextValue());
+            else if (arg == "--fen")
+                options.fen = nextValue();
+            else if (arg == "--divide")
+                options.divide = true;
+            else if (arg == "--threads")
+                options.threads = static_cast<unsigned>(std::stoul(nextValue()));
+            else if (arg == "--hash")
+                options.hashMegabytes = std::stoul(nextValue());
+            else if (arg == "--slider-backend")
+                options.sliderBackend = Attacks::parseSliderBackend(nextValue());
+            else
+                throw std::invalid_argument("Unknown option: " + arg);
+        }
+
+        if (options.depth < 1)
+            throw std::invalid_argument("Depth must be at least 1");
+        if (options.threads == 0)
+            options.threads = 1;
+
+        return options;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        Options options = parseOptions(argc, argv);
+        Attacks::init(options.sliderBackend);
+
+        Position root;
+        root.setFromFen(options.fen);
+
+        MoveList rootMoves;
+        MoveGen::generateLegalMoves(root, root.getSideToMove(), rootMoves);
+
+        std::unique_ptr<PerftTable> table;
+        if (options.hashMegabytes > 0)
+            table = std::make_unique<PerftTable>(options.hashMegabytes);
+
+        auto start = std::chrono::steady_clock::now();
+
+        // root moves are handed out one at a time, each worker searches on its own copy of the position
+        std::vector<std::uint64_t> rootCounts(rootMoves.size(), 0);
+        std::atomic<int> nextMove{0};
+        auto worker = [&]()
+        {
+            Position position = root;
+            for (int index = nextMove++; index < rootMoves.size(); index = nextMove++)
+            {
+                UndoInfo undo;
+                position.makeMove(rootMoves[index], undo);
+                rootCounts[index] = perft(position, options.depth - 1, table.get());
+                position.unmakeMove(rootMoves[index], undo);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        unsigned threadCount = std::min<unsigned>(options.threads, std::max(rootMoves.size(), 1));
+        for (unsigned i = 0; i < threadCount; ++i)
+            threads.emplace_back(worker);
+        for (auto &thread : threads)
+            thread.join();
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::uint64_t total = 0;
+        for (int i = 0; i < rootMoves.size(); ++i)
+        {
+            total += rootCounts[i];
+            if (options.divide)
+                std::cout << toUci(rootMoves[i]) << ": " << rootCounts[i] << std::endl;
+        }
+
+        std::uint64_t nodesPerSecond = total * 1000 / std::max<std::int64_t>(elapsed.count(), 1);
+
+        std::cout << "\nNodes: " << total << "\n"
+                  << "Time: " << elapsed.count() << " ms\n"
+                  << "NPS: " << nodesPerSecond << "\n"
+                  << "Threads: " << threadCount << ", hash: " << options.hashMegabytes << " MB, slider backend: "
+                  << Attacks::sliderBackendName(Attacks::getSliderBackend()) << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}